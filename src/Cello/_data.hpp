@@ -32,7 +32,11 @@ extern void png_array (const char * filename,
 // Defines
 //----------------------------------------------------------------------
 
-#define PARTICLE_ALIGN 16
+// byte alignment of each particle batch, and of each attribute array
+// within a batch for non-interleaved types (one cache line / widest
+// SIMD register)
+
+#define PARTICLE_ALIGN 64
 
 // integer limits on particle position within a Block:
 //
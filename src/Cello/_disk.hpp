@@ -14,6 +14,7 @@
 
 #include <hdf5.h>
 
+#include <algorithm>
 #include <string>
 
 //----------------------------------------------------------------------
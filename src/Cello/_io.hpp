@@ -13,6 +13,8 @@
 //----------------------------------------------------------------------
 
 #include <limits>
+#include <list>
+#include <sstream>
 #include <boost/filesystem.hpp>
 #include "pngwriter.h"
 
@@ -45,6 +47,7 @@ enum meta_type {
 #include "io_OutputImage.hpp"
 #include "io_OutputData.hpp"
 #include "io_OutputCheckpoint.hpp"
+#include "io_OutputReduce.hpp"
 
 #include "io_Schedule.hpp"
 #include "io_ScheduleList.hpp"
@@ -36,6 +36,10 @@ enum neighbor_enum {
 #include <vector>
 #include <limits>
 #include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <set>
 
 #include "pngwriter.h"
 
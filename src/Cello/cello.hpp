@@ -20,6 +20,7 @@
 
 #include <stdio.h>
 #include <math.h>
+#include <stdint.h>
 
 #include <map>
 #include <memory>
@@ -303,6 +304,26 @@ namespace cello {
 
   void backtrace(const char * msg);
 
+  /// Return the Morton (Z-order) key of the given non-negative cell
+  /// indices, each less than 2^21.  Unused axes should be 0, so keys
+  /// of 8x8x8 tiles (or 8x8 in 2D) share all but the lowest 9 bits
+
+  inline int64_t morton_key (int ix, int iy = 0, int iz = 0)
+  {
+    int64_t key = 0;
+    const int64_t i3[3] = { ix, iy, iz };
+    for (int axis=0; axis<3; axis++) {
+      int64_t i = i3[axis] & 0x1fffff;
+      i = (i | (i << 32)) & 0x1f00000000ffffLL;
+      i = (i | (i << 16)) & 0x1f0000ff0000ffLL;
+      i = (i | (i <<  8)) & 0x100f00f00f00f00fLL;
+      i = (i | (i <<  4)) & 0x10c30c30c30c30c3LL;
+      i = (i | (i <<  2)) & 0x1249249249249249LL;
+      key |= (i << axis);
+    }
+    return key;
+  }
+
   inline int index_static()
   { return CkMyPe() % CONFIG_NODE_SIZE; }
 
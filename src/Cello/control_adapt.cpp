@@ -426,6 +426,14 @@ void Block::particle_scatter_children_ (ParticleData * particle_list[],
   const double y0 = 0.5*(ym+yp);
   const double z0 = 0.5*(zm+zp);
 
+  // ...work arrays, reused across batches (heap-allocated since
+  // batch sizes may be too large for the stack)
+
+  std::vector<double> xa,ya,za;
+  std::vector<int>    index;
+  std::unique_ptr<bool[]> mask;
+  int mask_size = 0;
+
   // for each particle type to be moved
 
   const int nt = particle.num_types();
@@ -439,12 +447,14 @@ void Block::particle_scatter_children_ (ParticleData * particle_list[],
     const int ia_x  = particle.attribute_position(it,0);
 
     // (...positions may use absolute coordinates (float) or
-    // block-local coordinates (int))
+    // block-local coordinates (int), in which case children are
+    // split at 0 rather than at the Block center)
     const bool is_float = 
       (cello::type_is_float(particle.attribute_type(it,ia_x)));
 
-    // (...stride may be != 1 if particle attributes are interleaved)
-    const int d  = particle.stride(it,ia_x);
+    const double xc = is_float ? x0 : 0.0;
+    const double yc = is_float ? y0 : 0.0;
+    const double zc = is_float ? z0 : 0.0;
 
     // ...for each batch of particles
 
@@ -454,55 +464,68 @@ void Block::particle_scatter_children_ (ParticleData * particle_list[],
 
       const int np = particle.num_particles(it,ib);
 
+      if (np == 0) continue;
+
       // ...all particles will be moved
-      bool mask[np];
+      if (mask_size < np) {
+	mask.reset(new bool[np]);
+	mask_size = np;
+      }
       for (int ip=0; ip<np; ip++) {
 	mask[ip] = true;
       }
 
-      // ...extract particle position arrays
+      // ...extract particle position arrays (unit stride, since
+      // position() de-interleaves)
 
-      double xa[np],ya[np],za[np];
-      particle.position(it,ib,xa,ya,za);
+      xa.assign(np,0.0);
+      ya.assign(np,0.0);
+      za.assign(np,0.0);
+      particle.position(it,ib,&xa[0],&ya[0],&za[0]);
 
-      // ...initialize mask used for scatter and delete
-      // ...and corresponding particle indices
+      // ...initialize corresponding particle indices
 
-      int index[np];
+      index.resize(np);
 
-      if (is_float) {
-
-	// absolute coordinates
-
-	for (int ip=0; ip<np; ip++) {
+      for (int ip=0; ip<np; ip++) {
 
 #ifdef DEBUG_NEW_REFRESH
     CkPrintf ("DEBUG_NEW_REFRESH scatter particle %d\n",ip);
 #endif
 
-	  double x = xa[ip*d];
-	  double y = ya[ip*d];
-	  double z = za[ip*d];
-
-	  int ix = (rank >= 1) ? ( (x < x0) ? 0 : 1) : 0;
-	  int iy = (rank >= 2) ? ( (y < y0) ? 0 : 1) : 0;
-	  int iz = (rank >= 3) ? ( (z < z0) ? 0 : 1) : 0;
+	int ix = (rank >= 1) ? ( (xa[ip] < xc) ? 0 : 1) : 0;
+	int iy = (rank >= 2) ? ( (ya[ip] < yc) ? 0 : 1) : 0;
+	int iz = (rank >= 3) ? ( (za[ip] < zc) ? 0 : 1) : 0;
 
-	  // save index of ip'th particle's destination Particle object 
-	  index[ip] = ix + 2*(iy + 2*iz);
-	}
-
-      } else {
-	ERROR("Block::particle_scatter_children_",
-	      "Relative (integer) positions not supported");
+	// save index of ip'th particle's destination Particle object 
+	index[ip] = ix + 2*(iy + 2*iz);
       }
 
       // ...scatter particles to particle array
-      particle.scatter (it,ib, np, mask, index, npa, particle_list);
+      particle.scatter (it,ib, np, mask.get(), &index[0], npa, particle_list);
       // ... delete scattered particles
-      count += particle.delete_particles (it,ib,mask);
+      count += particle.delete_particles (it,ib,mask.get());
     }
   }
+
+  // transform block-local integer positions to child Block frames
+
+  ItChild it_child (rank);
+  int ic3[3];
+  while (it_child.next(ic3)) {
+    const int i = ic3[0] + 2*(ic3[1] + 2*ic3[2]);
+    double d3[3] = {0.0, 0.0, 0.0};
+    for (int axis=0; axis<rank; axis++) d3[axis] = 0.5 - ic3[axis];
+    Particle particle_child (particle.particle_descr(),particle_list[i]);
+    for (int it=0; it<nt; it++) {
+      if (particle_child.position_int_max(it) == 0) continue;
+      const int nb = particle_child.num_batches(it);
+      for (int ib=0; ib<nb; ib++) {
+	particle_child.position_transform_int (it,ib,d3,+1);
+      }
+    }
+  }
+
   cello::simulation()->data_delete_particles(count);
 }
 
@@ -834,6 +857,22 @@ void Block::adapt_coarsen_()
 
   const Index index_parent = index_.index_parent();
 
+  // Transform block-local integer particle positions to the parent
+  // Block frame (this Block is deleted after coarsening)
+
+  Particle particle = data()->particle();
+  const int rank = cello::rank();
+  double d3[3] = {0.0, 0.0, 0.0};
+  for (int axis=0; axis<rank; axis++) d3[axis] = 2*ic3[axis] - 1;
+  const int nt = particle.num_types();
+  for (int it=0; it<nt; it++) {
+    if (particle.position_int_max(it) == 0) continue;
+    const int nb = particle.num_batches(it);
+    for (int ib=0; ib<nb; ib++) {
+      particle.position_transform_int (it,ib,d3,-1);
+    }
+  }
+
   // Create data message object to send
 
   DataMsg * data_msg = new DataMsg;
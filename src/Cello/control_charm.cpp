@@ -126,6 +126,10 @@ void Block::refresh_exit_()
 {
   TRACE_CONTROL("refresh_exit");
 
+  if (refresh_.back()->any_particles()) {
+    particle_compress_(refresh_.back());
+  }
+
   update_boundary_();
 
   // CkCallback (refresh_.back()->callback(),thisProxy).send(NULL);
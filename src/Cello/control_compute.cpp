@@ -38,6 +38,7 @@ void Block::compute_begin_ ()
   cello::simulation()->set_phase(phase_compute);
 
   index_method_ = 0;
+  method_time_  = 0.0;
   compute_next_();
 }
 
@@ -105,9 +106,12 @@ void Block::compute_continue_ ()
       CkPrintf ("%d %s DEBUG_COMPUTE applying Method %s\n",
 	      CkMyPe(),name().c_str(),method->name().c_str());
 #endif
-    // Apply the method to the Block
+    // Apply the method to the Block, accumulating the local time
+    // spent for the Balance:weight_time load model
 
+    method_start_ = CkWallTimer();
     method -> compute (this);
+    method_time_stop_();
     performance_stop_(perf_compute,__FILE__,__LINE__);
 
   } else {
@@ -126,12 +130,27 @@ void Block::compute_done ()
   if (cycle() >= CYCLE)
     CkPrintf ("%d %s DEBUG_COMPUTE Block::compute_done_()\n", CkMyPe(),name().c_str());
 #endif
+  method_time_stop_();
   index_method_++;
   compute_next_();
 }
 
 //----------------------------------------------------------------------
 
+void Block::method_time_stop_ ()
+{
+  // Methods may call compute_done() before returning from compute(),
+  // or only later after communication: count only the time until
+  // whichever comes first, so nested Methods are not counted twice
+
+  if (method_start_ > 0.0) {
+    method_time_ += CkWallTimer() - method_start_;
+    method_start_ = 0.0;
+  }
+}
+
+//----------------------------------------------------------------------
+
 void Block::compute_end_ ()
 {
 #ifdef DEBUG_COMPUTE
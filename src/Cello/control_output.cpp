@@ -171,15 +171,9 @@ void Problem::output_next(Simulation * simulation) throw()
 
     output->next();  // update Output's schedule
     
-    // Perform output if any...
+    // Perform output if any: all processes write concurrently
 
-    const int stride = output->stride_wait();
-
-    if ((CkMyPe() % stride) == 0) {
-
-      simulation->output_start (index_output_);
-
-    }
+    simulation->output_start (index_output_);
 
   } else {
 
@@ -276,6 +270,16 @@ void Simulation::r_write_checkpoint()
 
 //----------------------------------------------------------------------
 
+void Simulation::r_write_checkpoint_memory()
+{
+  performance_->start_region(perf_output);
+  TRACE_OUTPUT("Simulation::r_write_checkpoint_memory()");
+  problem()->output_wait(this);
+  performance_->stop_region(perf_output);
+}
+
+//----------------------------------------------------------------------
+
 void Problem::output_wait(Simulation * simulation) throw()
 {
   TRACE_OUTPUT("Problem::output_wait()");
@@ -283,10 +287,12 @@ void Problem::output_wait(Simulation * simulation) throw()
   Output * output = this->output(index_output_);
 
   const int ip = CkMyPe();
-  const int np = CkNumPes();
   const int ip_write = output->process_writer();
 
-  if (ip == ip_write) {
+  // with tree reduction every process combines its children's data
+  // with its own before sending to its parent in output_write()
+
+  if (ip == ip_write || output->is_tree_reduce()) {
 
     output_write(simulation,0,0);
 
@@ -305,13 +311,9 @@ void Problem::output_wait(Simulation * simulation) throw()
 
     output->close();
     output->finalize();
+    simulation->output_link(index_output_);
+    proxy_simulation[CkMyPe()].p_output_drain(index_output_);
     output_next(simulation);
-    
-    const int stride = output->stride_wait();
-    const int ip_next = ip+1;
-    if (ip_next%stride != 0 && ip_next < np) {
-      proxy_simulation[ip_next].p_output_start(index_output_);
-    }
   }
 }
 
@@ -343,17 +345,22 @@ void Problem::output_write
 
     TRACE_OUTPUT("Problem::output_write(): sync_write()->next() = true");
 
+    if (! output->is_writer()) {
+
+      // Send data combined over this process's subtree to its parent
+
+      int n=0;  char * buffer = 0;
+      output->prepare_remote(&n,&buffer);
+      proxy_simulation[output->process_parent()].p_output_write (n, buffer);
+      output->cleanup_remote(&n,&buffer);
+    }
+
     output->close();
     output->finalize();
+    simulation->output_link(index_output_);
+    proxy_simulation[CkMyPe()].p_output_drain(index_output_);
     output_next(simulation);
 
-    const int stride = output->stride_wait();
-    const int ip = CkMyPe();
-    const int ip_next = ip+1;
-    const int np = CkNumPes();
-    if (ip_next%stride != 0 && ip_next < np) {
-      proxy_simulation[ip_next].p_output_start(index_output_);
-    }
   } else {
     TRACE_OUTPUT("Problem::output_write(): sync_write()->next() = false");
   }
@@ -362,6 +369,63 @@ void Problem::output_write
 
 //----------------------------------------------------------------------
 
+void Simulation::output_link(int index_output)
+{
+  TRACE_OUTPUT("Simulation::output_link()");
+
+  // Gather all processes' Block entries to the root, which writes
+  // a single file linking to each Block group in the written files
+
+  Output * output = problem()->output(index_output);
+
+  if (output->is_linked()) {
+    std::string entries = output->link_entries();
+    CkCallback callback (CkIndex_Simulation::r_output_link(NULL), 0,
+			 thisProxy);
+    contribute (entries.size(),entries.data(),CkReduction::concat,callback);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::r_output_link(CkReductionMsg * msg)
+{
+  TRACE_OUTPUT("Simulation::r_output_link()");
+  performance_->start_region(perf_output);
+
+  std::string entries ((char *)msg->getData(), msg->getSize());
+  delete msg;
+
+  // entries begin with the index of the Output object
+
+  int index_output;
+  if (sscanf (entries.c_str(),"%d",&index_output) == 1) {
+    problem()->output(index_output)->write_link(entries);
+  }
+
+  performance_->stop_region(perf_output);
+}
+
+//----------------------------------------------------------------------
+
+void Simulation::p_output_drain(int index_output)
+{
+  TRACE_OUTPUT("Simulation::p_output_drain()");
+
+  // Write one staged Block per message, so asynchronous output is
+  // interleaved with Block entry methods on this process
+
+  performance_->start_region(perf_output);
+
+  if (problem()->output(index_output)->write_staged()) {
+    thisProxy[CkMyPe()].p_output_drain(index_output);
+  }
+
+  performance_->stop_region(perf_output);
+}
+
+//----------------------------------------------------------------------
+
 void Simulation::output_exit()
 {
   TRACE_OUTPUT("Simulation::output_exit()");
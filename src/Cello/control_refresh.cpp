@@ -250,8 +250,8 @@ int Block::refresh_load_particle_faces_ (Refresh * refresh)
 
   const int npa = (rank == 1) ? 4 : ((rank == 2) ? 4*4 : 4*4*4);
 
-  ParticleData * particle_array[npa];
-  ParticleData * particle_list [npa];
+  ParticleData * particle_array[4*4*4];
+  ParticleData * particle_list [4*4*4];
   Index * index_list = new Index[npa];
   
   for (int i=0; i<npa; i++) {
@@ -350,6 +350,10 @@ int Block::particle_load_faces_ (int npa,
 
   particle_apply_periodic_update_  (nl,particle_list,refresh);
 
+  // Update block-local integer positions to neighbor Block frames
+
+  particle_apply_local_update_  (nl,particle_list,refresh);
+
   return nl;
 }
 
@@ -469,13 +473,7 @@ void Block::particle_apply_periodic_update_
   const int level = this->level();
   const int min_face_rank = refresh->min_face_rank();
 
-  double dpx[nl],dpy[nl],dpz[nl];
-
-  for (int i=0; i<nl; i++) {
-    dpx[i]=0.0;
-    dpy[i]=0.0;
-    dpz[i]=0.0; 
-  }
+  std::vector<double> dpx(nl,0.0), dpy(nl,0.0), dpz(nl,0.0);
 
   // Compute position updates for particles crossing periodic boundaries
 
@@ -525,6 +523,10 @@ void Block::particle_apply_periodic_update_
       const int nt = particle_neighbor.num_types();
       for (int it=0; it<nt; it++) {
 
+	// ... block-local integer positions are handled in
+	// particle_apply_local_update_()
+	if (particle_neighbor.position_int_max(it) != 0) continue;
+
 	// ... for each batch of particles
 	const int nb = particle_neighbor.num_batches(it);
 	for (int ib=0; ib<nb; ib++) {
@@ -536,6 +538,88 @@ void Block::particle_apply_periodic_update_
     }
   }
 }
+
+//----------------------------------------------------------------------
+
+void Block::particle_apply_local_update_
+(int nl, ParticleData * particle_list[], Refresh * refresh)
+{
+  ParticleDescr * p_descr = cello::particle_descr();
+
+  // Skip if no particle types use block-local integer positions
+
+  const int nt = p_descr->num_types();
+  bool any_int = false;
+  for (int it=0; it<nt; it++) {
+    any_int = any_int || (p_descr->position_int_max(it) != 0);
+  }
+  if (! any_int) return;
+
+  const int rank = cello::rank();
+  const int level = this->level();
+  const int min_face_rank = refresh->min_face_rank();
+
+  ItNeighbor it_neighbor = this->it_neighbor(min_face_rank,index_,neighbor_leaf,0,0);
+
+  int il=0;
+
+  int if3[3];
+  while (it_neighbor.next(if3)) {
+
+    ASSERT2 ("Block::particle_apply_local_update_",
+	     "Neighbor index %d exceeds neighbor count %d",
+	     il,nl,
+	     il < nl);
+
+    const int level_face = it_neighbor.face_level();
+
+    int ic3[3] = {0,0,0};
+
+    const int refresh_type = 
+      (level_face == level - 1) ? refresh_coarse :
+      (level_face == level)     ? refresh_same :
+      (level_face == level + 1) ? refresh_fine : refresh_unknown;
+
+    if (refresh_type==refresh_coarse) {
+      index_.child(index_.level(),ic3,ic3+1,ic3+2);
+    } else if (refresh_type==refresh_fine) {
+      it_neighbor.child(ic3);
+    }
+
+    int index_lower[3] = {0,0,0};
+    int index_upper[3] = {1,1,1};
+    refresh->index_limits (rank,refresh_type,if3,ic3,index_lower,index_upper);
+
+    // Offset of this Block's center from the neighbor's center, in
+    // units of half this Block's width, and the change in level
+
+    double d3[3] = {0.0, 0.0, 0.0};
+    int s = 0;
+    for (int axis=0; axis<rank; axis++) {
+      if (refresh_type == refresh_same) {
+	d3[axis] = -2.0*if3[axis];
+      } else if (refresh_type == refresh_fine) {
+	d3[axis] = -(index_lower[axis] - 1.5);
+	s = +1;
+      } else if (refresh_type == refresh_coarse) {
+	d3[axis] = -((1 - 2*ic3[axis]) + 4*if3[axis]);
+	s = -1;
+      }
+    }
+
+    Particle particle_neighbor (p_descr,particle_list[il]);
+
+    for (int it=0; it<nt; it++) {
+      if (particle_neighbor.position_int_max(it) == 0) continue;
+      const int nb = particle_neighbor.num_batches(it);
+      for (int ib=0; ib<nb; ib++) {
+	particle_neighbor.position_transform_int (it,ib,d3,s);
+      }
+    }
+
+    il++;
+  }
+}
 //----------------------------------------------------------------------
 
 void Block::particle_scatter_neighbors_
@@ -561,6 +645,15 @@ void Block::particle_scatter_neighbors_
   const double zl = zp-zm;
 
   int count = 0;
+
+  // ...work arrays, reused across batches (heap-allocated since
+  // batch sizes may be too large for the stack)
+
+  std::vector<double> xa,ya,za;
+  std::vector<int>    index;
+  std::unique_ptr<bool[]> mask;
+  int mask_size = 0;
+
   // ...for each particle type to be moved
 
   for (auto it_type=type_list.begin(); it_type!=type_list.end(); it_type++) {
@@ -574,9 +667,6 @@ void Block::particle_scatter_neighbors_
     const bool is_float = 
       (cello::type_is_float(particle.attribute_type(it,ia_x)));
 
-    // (...stride may be != 1 if particle attributes are interleaved)
-    const int d  = particle.stride(it,ia_x);
-
     // ...for each batch of particles
 
     const int nb = particle.num_batches(it);
@@ -585,21 +675,30 @@ void Block::particle_scatter_neighbors_
 
       const int np = particle.num_particles(it,ib);
 
-      // ...extract particle position arrays
+      if (np == 0) continue;
 
-      double xa[np],ya[np],za[np];
-      particle.position(it,ib,xa,ya,za);
+      // ...extract particle position arrays (unit stride, since
+      // position() de-interleaves)
+
+      xa.assign(np,0.0);
+      ya.assign(np,0.0);
+      za.assign(np,0.0);
+      particle.position(it,ib,&xa[0],&ya[0],&za[0]);
 
       // ...initialize mask used for scatter and delete
       // ...and corresponding particle indices
 
-      bool mask[np];
-      int index[np];
+      if (mask_size < np) {
+	mask.reset(new bool[np]);
+	mask_size = np;
+      }
+      index.resize(np);
+      int num_out = 0;
       for (int ip=0; ip<np; ip++) {
 
-	double x = is_float ? 2.0*(xa[ip*d]-x0)/xl : xa[ip*d];
-	double y = is_float ? 2.0*(ya[ip*d]-y0)/yl : ya[ip*d];
-	double z = is_float ? 2.0*(za[ip*d]-z0)/zl : za[ip*d];
+	double x = is_float ? 2.0*(xa[ip]-x0)/xl : xa[ip];
+	double y = is_float ? 2.0*(ya[ip]-y0)/yl : ya[ip];
+	double z = is_float ? 2.0*(za[ip]-z0)/zl : za[ip];
 
 	int ix = (rank >= 1) ? (x + 2) : 0;
 	int iy = (rank >= 2) ? (y + 2) : 0;
@@ -611,7 +710,7 @@ void Block::particle_scatter_neighbors_
 	  
 	  CkPrintf ("%d ix iy iz %d %d %d\n",CkMyPe(),ix,iy,iz);
 	  CkPrintf ("%d x y z %f %f %f\n",CkMyPe(),x,y,z);
-	  CkPrintf ("%d xa ya za %f %f %f\n",CkMyPe(),xa[ip*d],ya[ip*d],za[ip*d]);
+	  CkPrintf ("%d xa ya za %f %f %f\n",CkMyPe(),xa[ip],ya[ip],za[ip]);
 	  CkPrintf ("%d xm ym zm %f %f %f\n",CkMyPe(),xm,ym,zm);
 	  CkPrintf ("%d xp yp zp %f %f %f\n",CkMyPe(),xp,yp,zp);
 	  ERROR3 ("Block::particle_scatter_neighbors_",
@@ -626,12 +725,17 @@ void Block::particle_scatter_neighbors_
 	in_block = in_block && (!(rank >= 2) || (1 <= iy && iy <= 2));
 	in_block = in_block && (!(rank >= 3) || (1 <= iz && iz <= 2));
 	mask[ip] = ! in_block;
+	if (! in_block) ++num_out;
       }
 
+      // ...skip scatter and compaction if no particles left the Block
+
+      if (num_out == 0) continue;
+
       // ...scatter particles to particle array
-      particle.scatter (it,ib, np, mask, index, npa, particle_array);
+      particle.scatter (it,ib, np, mask.get(), &index[0], npa, particle_array);
       // ... delete scattered particles
-      count += particle.delete_particles (it,ib,mask);
+      count += particle.delete_particles (it,ib,mask.get());
     }
   }
 
@@ -676,3 +780,39 @@ void Block::particle_send_
 
   }
 }
+
+//----------------------------------------------------------------------
+
+void Block::particle_compress_ (Refresh * refresh)
+{
+  ParticleDescr * p_descr = cello::particle_descr();
+  Particle particle (p_descr, data()->particle_data());
+
+  std::vector<int> type_list;
+  if (refresh->all_particles()) {
+    const int nt = particle.num_types();
+    type_list.resize(nt);
+    for (int i=0; i<nt; i++) type_list[i] = i;
+  } else {
+    type_list = refresh->particle_list();
+  }
+
+  const float threshold = particle.compress_threshold();
+
+  for (size_t i=0; i<type_list.size(); i++) {
+    const int it = type_list[i];
+    const int np = particle.num_particles(it);
+    const int mb = particle.batch_size(it);
+
+    // only compress if it would free at least one batch
+
+    const bool compress = (threshold > 0.0) &&
+      (particle.num_batches(it) > (np + mb - 1) / mb) &&
+      (particle.efficiency(it) < threshold);
+
+    if (compress) particle.compress(it);
+
+    cello::simulation()->data_particle_stats
+      (it,np,particle.num_batches(it),compress);
+  }
+}
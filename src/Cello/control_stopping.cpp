@@ -244,6 +244,46 @@ void Block::ResumeFromSync()
 
 //----------------------------------------------------------------------
 
+void Block::UserSetLBLoad()
+{
+  setObjTime (load_model());
+}
+
+//----------------------------------------------------------------------
+
+double Block::load_model() const
+{
+  const Config * config = cello::config();
+
+  // cells: only leaf Blocks are updated by most Methods
+
+  int nx,ny,nz;
+  data()->field_data()->size(&nx,&ny,&nz);
+  const double cells = is_leaf() ? double(nx)*ny*nz : 0.0;
+
+  // particles: total over all particle types
+
+  Particle particle = const_cast<Block*>(this)->data()->particle();
+  const double particles = particle.num_particles();
+
+  return config->balance_weight_cells     * cells
+    +    config->balance_weight_particles * particles
+    +    config->balance_weight_time      * method_time_;
+}
+
+//----------------------------------------------------------------------
+
+bool Block::is_load_modeled_() const
+{
+  const Config * config = cello::config();
+  return (config != NULL) &&
+    (config->balance_weight_cells     != 0.0 ||
+     config->balance_weight_particles != 0.0 ||
+     config->balance_weight_time      != 0.0);
+}
+
+//----------------------------------------------------------------------
+
 void Block::exit_()
 {
 
@@ -273,6 +313,14 @@ void Block::exit_()
 		CkMyPe(),ParticleData::counter[in]);
     }
   }
+
+  // Complete any asynchronous output still staged on this process
+
+  Problem * problem = cello::problem();
+  for (int i=0; problem->output(i) != NULL; i++) {
+    problem->output(i)->flush();
+  }
+
   if (index_.is_root()) {
     proxy_main.p_exit(1);
   }
@@ -53,7 +53,7 @@ public: // interface
   bool operator== (const Particle & particle) throw ()
   {
     return (particle_descr_ == particle.particle_descr_) &&
-      (*particle_data_ == *particle.particle_data_);
+      particle_data_->equals(particle_descr_,*particle.particle_data_);
   }
 
   /// Destructor
@@ -143,7 +143,7 @@ public: // interface
   { particle_descr_->set_velocity (it,ix,iy,iz); }
 
   /// Byte offsets of attributes into block array.  Not including
-  /// initial offset for 16-byte alignment.
+  /// initial offset for PARTICLE_ALIGN-byte alignment.
 
   int attribute_offset(int it, int ia) const
   { return particle_descr_->attribute_offset(it,ia); }
@@ -245,6 +245,23 @@ public: // interface
   int batch_size() const
   { return particle_descr_->batch_size(); }
 
+  /// Return the batch size for the given type.
+
+  int batch_size(int it) const
+  { return particle_descr_->batch_size(it); }
+
+  /// Return the storage efficiency below which particles are
+  /// compressed after migration, or 0.0 if disabled
+
+  float compress_threshold() const
+  { return particle_descr_->compress_threshold(); }
+
+  /// Return the disorder fraction above which particles are sorted,
+  /// or 0.0 if sorting is disabled
+
+  float sort_threshold() const
+  { return particle_descr_->sort_threshold(); }
+
   /// Return the batch and particle index given a global particle
   /// index i.  This is useful e.g. for iterating over range of
   /// particles, e.g. initializing new particles after insert().
@@ -253,6 +270,9 @@ public: // interface
   void index (int i, int * ib, int * ip) const
   { particle_descr_->index(i,ib,ip); }
 
+  void index (int it, int i, int * ib, int * ip) const
+  { particle_descr_->index(it,i,ib,ip); }
+
   /// Return the Grouping object for the particle types
 
   Grouping * groups ()
@@ -269,9 +289,28 @@ public: // interface
       (particle_descr_, it,ia,ib); }
 
   const char * attribute_array (int it,int ia,int ib) const
-  { return particle_data_->attribute_array 
+  { return particle_data_->attribute_array
       (particle_descr_, it,ia,ib); }
 
+  /// Return the unit-stride, PARTICLE_ALIGN-aligned attribute array
+  /// of a non-interleaved particle type.  Arrays are padded to the
+  /// full batch size, so loops may safely run to a multiple of the
+  /// SIMD width beyond num_particles().
+
+  template <class T>
+  T * attribute_array_soa (int it,int ia,int ib)
+  {
+    ASSERT3 ("Particle::attribute_array_soa",
+	     "Type %d attribute %d must be non-interleaved with %d bytes",
+	     it,ia,int(sizeof(T)),
+	     (! interleaved(it)) && (attribute_bytes(it,ia) == sizeof(T)));
+    char * array = attribute_array(it,ia,ib);
+#ifdef __GNUC__
+    array = (char *) __builtin_assume_aligned (array,PARTICLE_ALIGN);
+#endif
+    return (T *) array;
+  }
+
   /// Return the number of batches of particles for the given type.
 
   int num_batches (int it) const
@@ -322,14 +361,28 @@ public: // interface
   { return particle_data_->gather(particle_descr_,it,n,particle_array); }
 
   /// Compress particles in batches so that all batches except
-  /// possibly the last have batch_size() particles.  May be performed
-  /// periodically to recover unused memory from multiple insert/deletes
+  /// possibly the last have batch_size(it) particles, preserving
+  /// particle order and deallocating emptied batches.  Performed
+  /// after migration when efficiency() drops below compress_threshold()
 
   void compress ()
   { particle_data_->compress(particle_descr_); }
   void compress (int it)
   { particle_data_->compress(particle_descr_,it); }
 
+  /// Return the fraction of consecutive particles of the given type
+  /// whose keys decrease in storage order.  key[] has one entry per
+  /// particle, ordered by batch then by particle within the batch.
+
+  float disorder (int it, const int64_t * key) const
+  { return particle_data_->disorder(particle_descr_,it,key); }
+
+  /// Reorder particles of the given type by non-negative key.  Equal
+  /// keys keep their relative order, and batches are compressed.
+
+  void sort (int it, const int64_t * key)
+  { particle_data_->sort(particle_descr_,it,key); }
+
   /// Return the storage "efficiency" for particles of the given type
   /// and in the given batch, or average if batch or type not specified.
   /// 1.0 means no wasted storage, 0.5 means twice as much storage
@@ -367,6 +420,27 @@ public: // interface
 			long double dx, long double dy, long double dz)
   { particle_data_->position_update (particle_descr_,it,ib,dx,dy,dz);  }
 
+  /// Fill unit-stride arrays with positions in cell units of a Block
+  /// of n3 cells spanning [xm3,xp3), so that cell i is [i,i+1)
+
+  bool position_cells (int it, int ib,
+		       const int n3[3], const double xm3[3],
+		       const double xp3[3],
+		       double * tx, double * ty = 0, double * tz = 0)
+  { return particle_data_->position_cells
+      (particle_descr_,it,ib,n3,xm3,xp3,tx,ty,tz); }
+
+  /// Transform block-local integer positions of a batch to the frame
+  /// of another Block; see ParticleData::position_transform_int()
+
+  void position_transform_int (int it, int ib, const double d3[3], int s)
+  { particle_data_->position_transform_int (particle_descr_,it,ib,d3,s); }
+
+  /// Return PMAX_<bits> if positions are block-local integers, else 0
+
+  int64_t position_int_max (int it) const
+  { return particle_descr_->position_int_max(it); }
+
   /// Fill a vector of velocity coordinates for the given type and batch
   bool velocity (int it, int ib,
 		 double * vx, double * vy = 0, double * vz = 0)
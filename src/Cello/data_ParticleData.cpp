@@ -7,6 +7,7 @@
 
 #include "data.hpp"
 #include <algorithm>
+#include <queue>
 
 // #define DEBUG_PARTICLES
 
@@ -24,12 +25,32 @@ ParticleData::ParticleData()
 
 //----------------------------------------------------------------------
 
-bool ParticleData::operator== (const ParticleData & particle_data) throw ()
+bool ParticleData::equals
+(ParticleDescr * particle_descr, const ParticleData & particle_data) const
 {
-  return 
-    (attribute_array_ == particle_data.attribute_array_) &&
-    (attribute_align_ == particle_data.attribute_align_) &&
-    (particle_count_  == particle_data.particle_count_);
+  if (particle_count_ != particle_data.particle_count_) return false;
+
+  // compare attribute values of each particle, since the alignment
+  // offset depends on where each batch was allocated
+
+  const int nt = particle_count_.size();
+  for (int it=0; it<nt; it++) {
+    const int nb = particle_count_[it].size();
+    const int na = particle_descr->num_attributes(it);
+    for (int ib=0; ib<nb; ib++) {
+      const int np = particle_count_[it][ib];
+      for (int ia=0; ia<na; ia++) {
+	const int mb = particle_descr->attribute_bytes(it,ia);
+	const int ms = particle_descr->stride(it,ia)*mb;
+	const char * a = attribute_array (particle_descr,it,ia,ib);
+	const char * b = particle_data.attribute_array (particle_descr,it,ia,ib);
+	for (int ip=0; ip<np; ip++) {
+	  if (memcmp(a+ip*ms,b+ip*ms,mb) != 0) return false;
+	}
+      }
+    }
+  }
+  return true;
 }
 
 //----------------------------------------------------------------------
@@ -39,6 +60,7 @@ void ParticleData::pup (PUP::er &p)
   p | attribute_array_;
   p | attribute_align_;
   p | particle_count_;
+  if (p.isUnpacking()) realign_();
 }
 
 //----------------------------------------------------------------------
@@ -49,16 +71,16 @@ ParticleData::~ParticleData()
 }
 //----------------------------------------------------------------------
 
-char * ParticleData::attribute_array (ParticleDescr * particle_descr,
-				      int it,int ia,int ib)
+const char * ParticleData::attribute_array (ParticleDescr * particle_descr,
+					    int it,int ia,int ib) const
 {
 
   bool in_range =        (0 <= it && it < particle_descr->num_types());
   in_range = in_range && (0 <= ia && ia < particle_descr->num_attributes(it));
   in_range = in_range && (0 <= ib && ib < num_batches(it));
 
-  char * array = NULL;
-  if ( in_range ) {
+  const char * array = NULL;
+  if ( in_range && attribute_array_[it][ib].size() > 0) {
     int offset = particle_descr->attribute_offset(it,ia);
     int align =  attribute_align_[it][ib];
     array = &attribute_array_[it][ib][0] + (offset + align);
@@ -125,7 +147,7 @@ int ParticleData::insert_particles
   // find indices of last batch and particle in batch for return value
 
   const int nb = num_batches(it);
-  const int mb = particle_descr->batch_size();
+  const int mb = particle_descr->batch_size(it);
 
   int ib_last,ip_last;
 
@@ -161,6 +183,7 @@ int ParticleData::insert_particles
       attribute_array_[it].resize(ib_this+1);
       attribute_align_[it].resize(ib_this+1);
       particle_count_ [it].resize(ib_this+1);
+      realign_(it);
     }
 
     // allocate particles
@@ -233,8 +256,7 @@ void ParticleData::scatter
 {
   // count number of particles in each particle_array element
 
-  int * np_array = new int[n];
-  for (int i=0; i<n; i++) np_array[i] = 0;
+  std::vector<int> np_array(n,0);
 
   if (mask == NULL) {
     for (int ip=0; ip<np; ip++) {
@@ -246,25 +268,34 @@ void ParticleData::scatter
     }
   }
   
-  // insert uninitialized particles
-  std::map<ParticleData *, int>  i_array;
-  std::map<ParticleData *, bool> is_first;
+  // map each element to the first element sharing its ParticleData
+  // object, which holds the shared insertion index (n is at most 64,
+  // so a linear search is cheaper than a std::map)
+
+  std::vector<int> k_first(n);
   for (int k=0; k<n; k++) {
-    ParticleData * pd = particle_array[k];
-    is_first[pd] = true;
-    i_array[pd] = 0;
+    k_first[k] = k;
+    for (int k0=0; k0<k; k0++) {
+      if (particle_array[k0] == particle_array[k]) {
+	k_first[k] = k0;
+	break;
+      }
+    }
   }
 
+  // insert uninitialized particles
+  std::vector<int>  i_array(n,0);
+  std::vector<bool> is_first(n,true);
+
   for (int k=0; k<n; k++) {
     ParticleData * pd = particle_array[k];
+    const int kf = k_first[k];
     if (np_array[k]>0 && pd) {
       int i0 = pd->insert_particles (particle_descr,it,np_array[k]);
-      if (is_first[pd]) i_array[pd] = i0;
-      is_first[pd] = false;
+      if (is_first[kf]) i_array[kf] = i0;
+      is_first[kf] = false;
     }
   }
-
-  delete [] np_array;
   
   const bool interleaved = particle_descr->interleaved(it);
   const int na = particle_descr->num_attributes(it);
@@ -278,9 +309,9 @@ void ParticleData::scatter
       ++count;
       int k = index[ip_src];
       ParticleData * pd = particle_array[k];
-      int i_dst = i_array[pd]++;
+      int i_dst = i_array[k_first[k]]++;
       int ib_dst,ip_dst;
-      particle_descr->index(i_dst,&ib_dst,&ip_dst);
+      particle_descr->index(it,i_dst,&ib_dst,&ip_dst);
       for (int ia=0; ia<na; ia++) {
 	if (!interleaved) 
 	  mp = particle_descr->attribute_bytes(it,ia);
@@ -307,10 +338,10 @@ int ParticleData::gather
   int count = 0;
   
   // Sort particle array to simplify skipping duplicates
-  ParticleData * particle_array_sorted[n];
-  for (int i=0; i<n; i++) particle_array_sorted[i] = particle_array[i];
-  std::sort(&particle_array_sorted[0],
-	    &particle_array_sorted[n]);
+  std::vector<ParticleData *> particle_array_sorted
+    (particle_array, particle_array + n);
+  std::sort(particle_array_sorted.begin(),
+	    particle_array_sorted.end());
 
   // count number of particles to insert
   int np = 0;
@@ -326,14 +357,14 @@ int ParticleData::gather
   int i_dst = insert_particles(particle_descr,it,np);
 
   int ib_dst,ip_dst;
-  particle_descr->index (i_dst,&ib_dst,&ip_dst);
+  particle_descr->index (it,i_dst,&ib_dst,&ip_dst);
 
   // initialize particles
   const bool interleaved = particle_descr->interleaved(it);
   const int na = particle_descr->num_attributes(it);
   int mp = particle_descr->particle_bytes(it);
 
-  const int mb = particle_descr->batch_size();
+  const int mb = particle_descr->batch_size(it);
 
   for (int k=0; k<n; k++) {
     // ...skip duplicate ParticleData objects
@@ -379,70 +410,225 @@ void ParticleData::compress (ParticleDescr * particle_descr)
 void ParticleData::compress (ParticleDescr * particle_descr, int it)
 {
   const int nb = num_batches(it);
-  const int mb = particle_descr->batch_size();
+  const int mb = particle_descr->batch_size(it);
   const int na = particle_descr->num_attributes(it);
 
   const bool interleaved = particle_descr->interleaved(it);
 
-  // find first batch with space in it
+  // particle counts before compressing, since destination batches
+  // may overtake source batches
 
-  int ib_src, ip_src; // source batch and particle indices
-  int ib_dst, ip_dst; // destination batch and particle indices
+  std::vector<int> np_src(nb);
+  int np = 0;
+  for (int ib=0; ib<nb; ib++) {
+    np_src[ib] = num_particles(particle_descr,it,ib);
+    np += np_src[ib];
+  }
 
-  int np_dst; // number of particles in ib_dst batch
-  int np_src; // number of particles in ib_src batch
+  const int nb_new = (np + mb - 1) / mb;
 
-  // find destination: first empty spot 
+  // destination: first batch with space in it
 
-  ib_dst=0;
-  np_dst=(ib_dst<nb) ? num_particles(particle_descr,it,ib_dst) : 0;
-  while (ib_dst<nb && np_dst == mb) {
-    ib_dst++;
-  } // assert ib_dst == nb || np_dst < mb
-  ip_dst = np_dst;
+  int ib_dst = 0;
+  while (ib_dst < nb && np_src[ib_dst] == mb) ib_dst++;
 
-  // first source: next non-empty spot
-  ib_src = ib_dst + 1;
-  ip_src = 0;
-  np_src = num_particles(particle_descr,it,ib_src);
+  if (ib_dst < nb) {
 
-  resize_attribute_array_ (particle_descr,it,ib_dst,mb);
-  np_dst = mb;
+    int ip_dst = np_src[ib_dst];
+    resize_attribute_array_ (particle_descr,it,ib_dst,mb);
 
-  int mp = particle_descr->particle_bytes(it);
+    // copy particles from later batches in order, so destination
+    // (ib_dst,ip_dst) never passes source (ib_src,ip_src)
+
+    for (int ib_src=ib_dst+1; ib_src<nb; ib_src++) {
+      for (int ip_src=0; ip_src<np_src[ib_src]; ip_src++) {
+	for (int ia=0; ia<na; ia++) {
+	  const int ny = particle_descr->attribute_bytes(it,ia);
+	  const int mp = interleaved ? particle_descr->particle_bytes(it) : ny;
+	  char * a_src = attribute_array(particle_descr,it,ia,ib_src);
+	  char * a_dst = attribute_array(particle_descr,it,ia,ib_dst);
+	  for (int iy=0; iy<ny; iy++) {
+	    a_dst [iy + mp*ip_dst] = a_src [iy + mp*ip_src];
+	  }
+	}
+	if (++ip_dst == mb) {
+	  ip_dst = 0;
+	  if (++ib_dst < nb_new) {
+	    resize_attribute_array_ (particle_descr,it,ib_dst,mb);
+	  }
+	}
+      }
+    }
+  }
+
+  // set final particle count and deallocate emptied batches
+
+  if (nb_new > 0) {
+    resize_attribute_array_ (particle_descr,it,nb_new-1,np-(nb_new-1)*mb);
+  }
+  attribute_array_[it].resize(nb_new);
+  attribute_align_[it].resize(nb_new);
+  particle_count_[it].resize(nb_new);
+}
+
+//----------------------------------------------------------------------
+
+float ParticleData::disorder
+(ParticleDescr * particle_descr, int it, const int64_t * key) const
+{
+  const int np = num_particles(particle_descr,it);
+  if (np < 2) return 0.0;
+
+  int nd = 0;
+  for (int i=1; i<np; i++) {
+    if (key[i] < key[i-1]) nd++;
+  }
+  return float(nd) / float(np-1);
+}
 
-  while (ib_src < nb && ip_src < np_src) {
+//----------------------------------------------------------------------
+
+namespace {
+
+  /// LSD radix sort of one batch's keys, 8 bits per pass; returns
+  /// particle indices within the batch in stable key order
 
-    for (int ia=0; ia<na; ia++) {
-      if (!interleaved) {
-	mp = particle_descr->attribute_bytes(it,ia);
+  void radix_sort_batch_
+  (const int64_t * key, int np, int num_passes,
+   std::vector<int> & index, std::vector<int> & scratch)
+  {
+    index.resize(np);
+    scratch.resize(np);
+    for (int ip=0; ip<np; ip++) index[ip] = ip;
+
+    for (int pass=0; pass<num_passes; pass++) {
+      const int shift = 8*pass;
+      int count[257] = {0};
+      for (int ip=0; ip<np; ip++) {
+	count[((key[ip] >> shift) & 0xff) + 1]++;
       }
-      int ny = particle_descr->attribute_bytes(it,ia);
-      char * a_src = attribute_array(particle_descr,it,ia,ib_src);
-      char * a_dst = attribute_array(particle_descr,it,ia,ib_dst);
-      for (int iy=0; iy<ny; iy++) {
-	a_dst [iy + mp*ip_dst] = a_src [iy + mp*ip_src];
+      for (int i=0; i<256; i++) count[i+1] += count[i];
+      for (int k=0; k<np; k++) {
+	const int ip = index[k];
+	scratch[count[(key[ip] >> shift) & 0xff]++] = ip;
       }
+      index.swap(scratch);
     }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void ParticleData::sort
+(ParticleDescr * particle_descr, int it, const int64_t * key)
+{
+  check_arrays_(particle_descr,__FILE__,__LINE__);
+
+  const int nb = num_batches(it);
+  const int np = num_particles(particle_descr,it);
+
+  if (np == 0) return;
+
+  // global index of first particle in each batch
+
+  std::vector<int> ip0(nb+1);
+  ip0[0] = 0;
+  for (int ib=0; ib<nb; ib++) {
+    ip0[ib+1] = ip0[ib] + num_particles(particle_descr,it,ib);
+  }
+
+  // number of radix passes needed for the largest key
+
+  int64_t key_max = 0;
+  for (int i=0; i<np; i++) {
+    ASSERT2("ParticleData::sort",
+	    "Particle %d has negative sort key %lld",
+	    i,(long long)key[i], key[i] >= 0);
+    key_max = std::max(key_max,key[i]);
+  }
+  int num_passes = 0;
+  while (key_max > 0) { key_max >>= 8; num_passes++; }
+
+  // sort each batch independently
+
+  std::vector< std::vector<int> > order(nb);
+  std::vector<int> scratch;
+  for (int ib=0; ib<nb; ib++) {
+    radix_sort_batch_ (key + ip0[ib], ip0[ib+1]-ip0[ib], num_passes,
+		       order[ib], scratch);
+  }
 
-    ip_dst++;
-    if (ip_dst>=np_dst) {
-      ip_dst = 0;
-      ib_dst++;
-      np_dst = mb;
-      if (ib_dst < nb) resize_attribute_array_ (particle_descr,it,ib_dst,mb);
+  // merge sorted batches into a global permutation; ties go to the
+  // lower batch to keep the sort stable
+
+  typedef std::pair< std::pair<int64_t,int>, int> merge_type;
+  std::priority_queue< merge_type, std::vector<merge_type>,
+		       std::greater<merge_type> > heap;
+  std::vector<int> next(nb,0);
+  for (int ib=0; ib<nb; ib++) {
+    if (! order[ib].empty()) {
+      const int i = ip0[ib] + order[ib][0];
+      heap.push(merge_type(std::make_pair(key[i],ib),i));
     }
+  }
 
-    ip_src++;
-    if (ip_src>=np_src) {
-      ip_src = 0;
-      ib_src++;
-      if (ib_src < nb) np_src = num_particles(particle_descr,it,ib_src);
+  std::vector<int> perm;
+  perm.reserve(np);
+  bool sorted = true;
+  while (! heap.empty()) {
+    const int ib = heap.top().first.second;
+    const int i  = heap.top().second;
+    heap.pop();
+    sorted = sorted && (i == (int)perm.size());
+    perm.push_back(i);
+    if (++next[ib] < (int)order[ib].size()) {
+      const int in = ip0[ib] + order[ib][next[ib]];
+      heap.push(merge_type(std::make_pair(key[in],ib),in));
     }
+  }
+
+  if (sorted) return;
+
+  // move current storage aside and copy particles back in sorted
+  // order, filling batches completely
+
+  std::vector< std::vector<char> > array_src;
+  std::vector< char > align_src = attribute_align_[it];
+  array_src.swap(attribute_array_[it]);
+
+  const int mb = particle_descr->batch_size(it);
+  const int nb_dst = (np + mb - 1) / mb;
+
+  attribute_array_[it].resize(nb_dst);
+  attribute_align_[it].resize(nb_dst);
+  particle_count_[it].resize(nb_dst);
+  for (int ib=0; ib<nb_dst; ib++) {
+    resize_attribute_array_ (particle_descr,it,ib,std::min(mb,np-ib*mb));
+  }
+
+  const bool interleaved = particle_descr->interleaved(it);
+  const int na = particle_descr->num_attributes(it);
+
+  // batch of each source particle
 
+  std::vector<int> ib_of(np);
+  for (int ib=0; ib<nb; ib++) {
+    for (int i=ip0[ib]; i<ip0[ib+1]; i++) ib_of[i] = ib;
   }
 
-  // deallocate empty batches?
+  for (int ia=0; ia<na; ia++) {
+    const int ny = particle_descr->attribute_bytes(it,ia);
+    const int mp = interleaved ? particle_descr->particle_bytes(it) : ny;
+    const int offset = particle_descr->attribute_offset(it,ia);
+    for (int i=0; i<np; i++) {
+      const int ib_src = ib_of[perm[i]];
+      const int ip_src = perm[i] - ip0[ib_src];
+      const char * a_src =
+	&array_src[ib_src][0] + offset + align_src[ib_src] + mp*ip_src;
+      char * a_dst = attribute_array(particle_descr,it,ia,i/mb) + mp*(i%mb);
+      for (int iy=0; iy<ny; iy++) a_dst[iy] = a_src[iy];
+    }
+  }
 }
   
 
@@ -451,10 +637,10 @@ void ParticleData::compress (ParticleDescr * particle_descr, int it)
 float ParticleData::efficiency (ParticleDescr * particle_descr)
 {
   int64_t bytes_min=0,bytes_used=0;
-  const int mb = particle_descr->batch_size();
 
   const int nt = particle_descr->num_types();
   for (int it=0; it<nt; it++) {
+    const int mb = particle_descr->batch_size(it);
     const int nb = num_batches(it);
     const int mp = particle_descr->particle_bytes(it);
     for (int ib=0; ib<nb; ib++) {
@@ -472,7 +658,7 @@ float ParticleData::efficiency (ParticleDescr * particle_descr)
 float ParticleData::efficiency (ParticleDescr * particle_descr, int it)
 {
   int64_t bytes_min=0,bytes_used=0;
-  const int mb = particle_descr->batch_size();
+  const int mb = particle_descr->batch_size(it);
 
   const int nb = num_batches(it);
   const int mp = particle_descr->particle_bytes(it);
@@ -491,7 +677,7 @@ float ParticleData::efficiency (ParticleDescr * particle_descr, int it, int ib)
 
   const int mp = particle_descr->particle_bytes(it);
   const int np = num_particles(particle_descr,it,ib);
-  const int mb = particle_descr->batch_size();
+  const int mb = particle_descr->batch_size(it);
 
   const int64_t bytes_min  = (int64_t)np*mp;
   const int64_t bytes_used = (int64_t)mb*mp;
@@ -548,6 +734,93 @@ bool ParticleData::position
 
 //----------------------------------------------------------------------
 
+bool ParticleData::position_cells
+(ParticleDescr * particle_descr,
+ int it, int ib,
+ const int n3[3], const double xm3[3], const double xp3[3],
+ double * tx, double * ty, double * tz)
+{
+  if (! position(particle_descr,it,ib,tx,ty,tz)) return false;
+
+  // block-local integer positions are in [-1,1) from position()
+
+  const bool is_int = (particle_descr->position_int_max(it) != 0);
+
+  const int np = num_particles(particle_descr,it,ib);
+  double * t3[3] = { tx, ty, tz };
+  for (int axis=0; axis<3; axis++) {
+    double * t = t3[axis];
+    if (t == NULL || particle_descr->attribute_position(it,axis) < 0) continue;
+    const double scale = is_int ? 0.5*n3[axis] : n3[axis]/(xp3[axis]-xm3[axis]);
+    const double lower = is_int ? -1.0 : xm3[axis];
+    for (int ip=0; ip<np; ip++) t[ip] = (t[ip] - lower)*scale;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+
+namespace {
+
+  /// a' = (a + d) 2^s, in wrapped unsigned arithmetic since only the
+  /// result need be in range for 64-bit positions.  For s < 0 the
+  /// offset dh = d/2 is added after halving a, which gives the same
+  /// floor since d is even
+
+  template <class T>
+  void transform_int_ (T * a, int stride, int np, uint64_t dh, int s)
+  {
+    for (int ip=0; ip<np; ip++) {
+      int64_t v = (int64_t) a[ip*stride];
+      if (s < 0) v >>= 1;
+      uint64_t u = (uint64_t) v + dh;
+      if (s > 0) u <<= 1;
+      a[ip*stride] = (T) (int64_t) u;
+    }
+  }
+
+}
+
+void ParticleData::position_transform_int
+(ParticleDescr * particle_descr, int it, int ib, const double d3[3], int s)
+{
+  if (particle_descr->position_int_max(it) == 0) return;
+
+  const int np = num_particles(particle_descr,it,ib);
+
+  for (int axis=0; axis<3; axis++) {
+    const int ia = particle_descr->attribute_position(it,axis);
+    if (ia < 0) continue;
+    if (d3[axis] == 0.0 && s == 0) continue;
+
+    const int type = particle_descr->attribute_type(it,ia);
+    const int dp = particle_descr->stride(it,ia);
+    char * array = attribute_array(particle_descr,it,ia,ib);
+
+    // offset d PMAX (or d PMAX / 2 if s < 0), with d a multiple of
+    // 1/2, which may exceed the int64 range, hence unsigned
+
+    const int64_t d2 = (int64_t) floor(2.0*d3[axis] + 0.5);
+    const int q = (s < 0) ? 4 : 2;
+
+    if (type == type_int8) {
+      transform_int_ ((int8_t *)  array, dp, np, d2*(PMAX_8/q), s);
+    } else if (type == type_int16) {
+      transform_int_ ((int16_t *) array, dp, np, d2*(PMAX_16/q), s);
+    } else if (type == type_int32) {
+      transform_int_ ((int32_t *) array, dp, np, d2*(PMAX_32/q), s);
+    } else if (type == type_int64) {
+      transform_int_ ((int64_t *) array, dp, np,
+		      (uint64_t) d2 * (uint64_t) (PMAX_64/q), s);
+    } else {
+      ERROR1("ParticleData::position_transform_int()",
+	     "Unknown particle position type %d", type);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
 bool ParticleData::velocity 
 (
  ParticleDescr * particle_descr,
@@ -930,6 +1203,8 @@ char * ParticleData::load_data (ParticleDescr * particle_descr,
     }
   }
 
+  realign_();
+
   return pc;
 }
 
@@ -994,14 +1269,16 @@ void ParticleData::write_ifrite (ParticleDescr * particle_descr,
   fprintf (fp,"%d\n",num_particles(particle_descr,it));
   fprintf (fp,"%f %f %f %f %f %f\n",xm,ym,zm,xp,yp,zp);
   const int nb = num_batches(it);
-  const int ia_x = particle_descr->attribute_position(it,0);
-  const int d = particle_descr->stride(it,ia_x);
+  std::vector<double> x,y,z;
   for (int ib=0; ib<nb; ib++) {
     const int np = num_particles(particle_descr,it,ib);
-    double x[np], y[np], z[np];
-    position (particle_descr,it,ib,x,y,z);
+    if (np == 0) continue;
+    x.assign(np,0.0);
+    y.assign(np,0.0);
+    z.assign(np,0.0);
+    position (particle_descr,it,ib,&x[0],&y[0],&z[0]);
     for (int ip=0; ip<np; ip++) {
-      fprintf (fp,"%f %f %f\n",x[ip*d],y[ip*d],z[ip*d]);
+      fprintf (fp,"%f %f %f\n",x[ip],y[ip],z[ip]);
     }
   }
   fflush(fp);
@@ -1019,11 +1296,12 @@ void ParticleData::resize_attribute_array_
 
   const int mp = particle_descr->particle_bytes(it);
 
-  if (!particle_descr->interleaved(it)) {
-    np = particle_descr->batch_size();
-  }
+  // non-interleaved batches are always allocated full size since
+  // attribute offsets depend on the batch size
 
-  long new_size = mp*(np) + (PARTICLE_ALIGN - 1) ;
+  long new_size = (particle_descr->interleaved(it) ?
+		   mp*(np) : particle_descr->batch_bytes(it))
+    + (PARTICLE_ALIGN - 1) ;
 
   if (attribute_array_[it][ib].size() != new_size) {
 
@@ -1031,16 +1309,61 @@ void ParticleData::resize_attribute_array_
 	    "Trying to allocate negative particles: new_size = %d",
 	    new_size, new_size >= 0);
       
+    const long old_size = attribute_array_[it][ib].size();
+    const int old_align = attribute_align_[it][ib];
+
     attribute_array_[it][ib].resize(new_size);
     char * array = &attribute_array_[it][ib][0];
     uintptr_t iarray = (uintptr_t) array;
     int defect = (iarray % PARTICLE_ALIGN);
     attribute_align_[it][ib] = (defect == 0) ? 0 : PARTICLE_ALIGN-defect;
+
+    // keep existing particles if reallocation changed the alignment
+
+    const long bytes = std::min(old_size,new_size) - (PARTICLE_ALIGN - 1);
+    if (bytes > 0 && old_align != attribute_align_[it][ib]) {
+      memmove (array + attribute_align_[it][ib], array + old_align, bytes);
+    }
   }
 }
 
 //----------------------------------------------------------------------
 
+void ParticleData::realign_ (int it, int ib)
+{
+  std::vector<char> & array = attribute_array_[it][ib];
+  const int size = array.size() - (PARTICLE_ALIGN - 1);
+  if (size <= 0) return;
+
+  const int align_old = attribute_align_[it][ib];
+  const uintptr_t iarray = (uintptr_t) &array[0];
+  const int defect = (iarray % PARTICLE_ALIGN);
+  const int align_new = (defect == 0) ? 0 : PARTICLE_ALIGN-defect;
+
+  if (align_new != align_old) {
+    memmove (&array[align_new], &array[align_old], size);
+    attribute_align_[it][ib] = align_new;
+  }
+}
+
+//----------------------------------------------------------------------
+
+void ParticleData::realign_ (int it)
+{
+  const int nb = attribute_array_[it].size();
+  for (int ib=0; ib<nb; ib++) realign_(it,ib);
+}
+
+//----------------------------------------------------------------------
+
+void ParticleData::realign_ ()
+{
+  const int nt = attribute_array_.size();
+  for (int it=0; it<nt; it++) realign_(it);
+}
+
+//----------------------------------------------------------------------
+
 void ParticleData::check_arrays_ (ParticleDescr * particle_descr,
 		    std::string file, int line) const
 {
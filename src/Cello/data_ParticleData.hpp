@@ -23,8 +23,9 @@ public: // interface
   /// Constructor
   ParticleData();
 
-  /// Comparison operator
-  bool operator== (const ParticleData & particle_data) throw ();
+  /// Return whether the particles and their attribute values are
+  /// equal, ignoring alignment padding and unused batch storage
+  bool equals (ParticleDescr *, const ParticleData & particle_data) const;
 
   /// Destructor
   ~ParticleData();
@@ -37,18 +38,29 @@ public: // interface
     attribute_array_ = particle_data.attribute_array_;
     attribute_align_ = particle_data.attribute_align_;
     particle_count_  = particle_data.particle_count_;
+    realign_();
+  }
+
+  /// Assignment operator
+  ParticleData & operator= (const ParticleData & particle_data)
+  {
+    attribute_array_ = particle_data.attribute_array_;
+    attribute_align_ = particle_data.attribute_align_;
+    particle_count_  = particle_data.particle_count_;
+    realign_();
+    return *this;
   }
   
   /// CHARM++ Pack / Unpack function
   void pup (PUP::er &p);
 
   /// Return the attribute array for the given particle type and batch
-  char * attribute_array (ParticleDescr *pd, int it, int ia, int ib);
-  const char * attribute_array (ParticleDescr *pd, int it, int ia, int ib) const
+  char * attribute_array (ParticleDescr *pd, int it, int ia, int ib)
   {
-    return (const char *)
-      ((ParticleData*)this) -> attribute_array (pd,it,ia,ib);
+    return (char *)
+      ((const ParticleData*)this) -> attribute_array (pd,it,ia,ib);
   }
+  const char * attribute_array (ParticleDescr *pd, int it, int ia, int ib) const;
 
   /// Return the number of batches of particles for the given type.
 
@@ -92,12 +104,26 @@ public: // interface
   int gather (ParticleDescr *, int it, int n, ParticleData * particle_array[]);
 
   /// Compress particles in batches so that all batches except
-  /// possibly the last have batch_size() particles.  May be performed
-  /// periodically to recover unused memory from multiple insert/deletes
+  /// possibly the last have batch_size(it) particles, preserving
+  /// particle order and deallocating emptied batches.  Performed
+  /// after migration when efficiency() drops below compress_threshold()
 
   void compress (ParticleDescr *);
   void compress (ParticleDescr *, int it);
 
+  /// Return the fraction of consecutive particles of the given type
+  /// whose keys decrease in storage order.  key[] has one entry per
+  /// particle, ordered by batch then by particle within the batch.
+
+  float disorder (ParticleDescr *, int it, const int64_t * key) const;
+
+  /// Reorder particles of the given type by non-negative key.  Each
+  /// batch is radix sorted, then batches are merged into compressed
+  /// batches.  Equal keys keep their relative order, and attribute
+  /// interleaving is preserved.
+
+  void sort (ParticleDescr *, int it, const int64_t * key);
+
   /// Return the storage "efficiency" for particles of the given type
   /// and in the given batch, or average if batch or type not specified.
   /// 1.0 means no wasted storage, 0.5 means twice as much storage
@@ -132,6 +158,7 @@ public: // interface
     if (particle_count_.size() < nt) {
       particle_count_.resize(nt);
     }
+    realign_();
   };
 
   /// Fill a vector of position coordinates for the given type and batch
@@ -144,6 +171,25 @@ public: // interface
   void position_update 
   (ParticleDescr * particle_descr,int it, int ib, 
    long double dx, long double dy, long double dz);
+
+  /// Fill unit-stride arrays with positions in cell units of a Block
+  /// of n3 cells spanning [xm3,xp3), so that cell i is [i,i+1).
+  /// Block-local integer positions are converted without reference
+  /// to the Block extents
+  bool position_cells (ParticleDescr * particle_descr,
+		       int it, int ib,
+		       const int n3[3], const double xm3[3],
+		       const double xp3[3],
+		       double * tx, double * ty = 0, double * tz = 0);
+
+  /// Transform block-local integer positions of a batch to the frame
+  /// of another Block, a' = (a + d PMAX) 2^s along each axis, where
+  /// d3 is the offset in units of half the Block width, and s is +1,
+  /// 0, or -1 if the other Block is one level finer, the same level,
+  /// or one level coarser.  Floating-point positions are unchanged.
+  void position_transform_int
+  (ParticleDescr * particle_descr, int it, int ib,
+   const double d3[3], int s);
 			 
   /// Fill a vector of velocity coordinates for the given type and batch
   bool velocity (ParticleDescr * particle_descr,
@@ -176,10 +222,19 @@ private: /// functions
 
   /// long long assign_id_ ()
 
-  /// Allocate attribute_array_ block, aligned at 16 byte boundary
-  /// with updated attribute_align_
+  /// Allocate attribute_array_ block, aligned at PARTICLE_ALIGN byte
+  /// boundary with updated attribute_align_
   void resize_attribute_array_ (ParticleDescr *, int it, int ib, int np);
 
+  /// Shift a batch's contents to restore PARTICLE_ALIGN alignment,
+  /// which may be lost when the array is copied, e.g. by pup(),
+  /// load_data(), or when the batch vector is reallocated
+  void realign_ (int it, int ib);
+
+  /// Restore alignment of all batches of the given type, or of all types
+  void realign_ (int it);
+  void realign_ ();
+
   void check_arrays_ (ParticleDescr * particle_descr,
 		      std::string file, int line) const;
 
@@ -221,8 +276,8 @@ private: /// attributes
   /// Array of blocks of particle attributes array_[it][ib][iap];
   std::vector< std::vector< std::vector<char> > > attribute_array_;
 
-  /// Alignment adjustment to correct for 16-byte alignment of
-  /// first attribute in each batch
+  /// Alignment adjustment to correct for PARTICLE_ALIGN-byte
+  /// alignment of first attribute in each batch
 
   std::vector< std::vector< char > > attribute_align_;
 
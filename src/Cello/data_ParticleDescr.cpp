@@ -38,7 +38,10 @@ ParticleDescr::ParticleDescr() throw()
     attribute_interleaved_(),
     attribute_offset_(),
     groups_(),
-    batch_size_(0)
+    batch_size_(0),
+    type_batch_size_(),
+    sort_threshold_(0.0),
+    compress_threshold_(0.0)
 {
 }
 
@@ -65,6 +68,9 @@ void ParticleDescr::pup (PUP::er &p)
   p | attribute_offset_;
   p | groups_;
   p | batch_size_;
+  p | type_batch_size_;
+  p | sort_threshold_;
+  p | compress_threshold_;
 }
 
 //----------------------------------------------------------------------
@@ -87,6 +93,7 @@ int ParticleDescr::new_type(std::string type_name)
   type_name_.push_back(type_name);
   attribute_interleaved_.push_back(false);
   particle_bytes_.push_back(0);
+  type_batch_size_.push_back(0);
 
   type_index_[type_name] = nt;
 
@@ -181,10 +188,13 @@ int ParticleDescr::new_attribute (int it, std::string name, int type)
 
   // compute offset of next attribute
 
-  const int increment = attribute_interleaved_[it] ? 1 : batch_size_;
+  // (non-interleaved attribute arrays are padded to keep the next
+  // one aligned)
 
-  attribute_offset_[it].push_back
-    (attribute_offset_[it][na] + increment * attribute_bytes_[it][na]);
+  const int bytes = attribute_interleaved_[it] ? attribute_bytes_[it][na]
+    : align_(batch_size(it) * attribute_bytes_[it][na], PARTICLE_ALIGN);
+
+  attribute_offset_[it].push_back (attribute_offset_[it][na] + bytes);
 
   // update particle bytes
   if (attribute_interleaved_[it]) {
@@ -479,6 +489,53 @@ int ParticleDescr::batch_size () const
 
 //----------------------------------------------------------------------
 
+int64_t ParticleDescr::position_int_max (int it) const
+{
+  ASSERT1("ParticleDescr::position_int_max",
+	  "Trying to access unknown particle type %d",
+	  it,
+	  check_(it));
+
+  const int ia = attribute_position_[it][0];
+  const int type = (ia >= 0) ? attribute_type_[it][ia] : type_unknown;
+
+  switch (type) {
+  case type_int8:  return PMAX_8;
+  case type_int16: return PMAX_16;
+  case type_int32: return PMAX_32;
+  case type_int64: return PMAX_64;
+  default:         return 0;
+  }
+}
+
+//----------------------------------------------------------------------
+
+int ParticleDescr::batch_size (int it) const
+{
+  ASSERT1("ParticleDescr::batch_size",
+	  "Trying to access unknown particle type %d",
+	  it,
+	  check_(it));
+  return (type_batch_size_[it] > 0) ? type_batch_size_[it] : batch_size_;
+}
+
+//----------------------------------------------------------------------
+
+void ParticleDescr::set_batch_size (int it, int batch_size)
+{
+  ASSERT1("ParticleDescr::set_batch_size",
+	  "Trying to access unknown particle type %d",
+	  it,
+	  check_(it));
+  ASSERT1("ParticleDescr::set_batch_size",
+	  "Batch size of particle type %s must be set before its attributes",
+	  type_name_[it].c_str(),
+	  num_attributes(it) == 0);
+  type_batch_size_[it] = batch_size;
+}
+
+//----------------------------------------------------------------------
+
 void ParticleDescr::index (int i, int * ib, int * ip) const
 {
   *ib = i / batch_size_;
@@ -487,6 +544,28 @@ void ParticleDescr::index (int i, int * ib, int * ip) const
 
 //----------------------------------------------------------------------
 
+void ParticleDescr::index (int it, int i, int * ib, int * ip) const
+{
+  const int mb = batch_size(it);
+  *ib = i / mb;
+  *ip = i % mb;
+}
+
+//----------------------------------------------------------------------
+
+int ParticleDescr::batch_bytes (int it) const
+{
+  ASSERT1("ParticleDescr::batch_bytes",
+	  "Trying to access unknown particle type %d",
+	  it,
+	  check_(it));
+
+  return attribute_interleaved_[it] ?
+    particle_bytes_[it] * batch_size(it) : attribute_offset_[it].back();
+}
+
+//----------------------------------------------------------------------
+
 int ParticleDescr::attribute_offset (int it, int ia) const
 {
   ASSERT2("ParticleDescr::attribute_offset",
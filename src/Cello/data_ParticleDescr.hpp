@@ -99,9 +99,15 @@ public: // interface
   std::string attribute_name (int it, int ia) const;
 
   /// Byte offsets of attributes into block array.  Not including
-  /// initial offset for 16-byte alignment.
+  /// initial offset for PARTICLE_ALIGN-byte alignment.  For
+  /// non-interleaved types each attribute array is padded to a
+  /// multiple of PARTICLE_ALIGN bytes, so all are aligned.
   int attribute_offset(int it, int ia) const;
 
+  /// Return the number of bytes used by a full batch of particles of
+  /// the given type, including padding
+  int batch_bytes (int it) const;
+
   /// Define which attributes represent position coordinates (-1 if not defined)
   void set_position (int it, int ix, int iy=-1, int iz=-1);
 
@@ -140,6 +146,11 @@ public: // interface
     return attribute_position_[it][axis];
   }
 
+  /// Return PMAX_<bits> if positions of the given type are
+  /// block-local integers, spanning [-PMAX,PMAX) in the Block, or 0 if
+  /// positions are floating-point (or undefined)
+  int64_t position_int_max (int it) const;
+
   /// Return the attribute corresponding to the given velocity
   /// coordinate, -1 if none
   int attribute_velocity (int it, int axis)
@@ -169,6 +180,36 @@ public: // interface
 
   int batch_size() const;
 
+  /// Set the batch size for the given type, overriding the default
+  /// batch_size().  Must be called before attributes are added.
+
+  void set_batch_size(int it, int batch_size);
+
+  /// Return the batch size for the given type
+
+  int batch_size(int it) const;
+
+  /// Set the storage efficiency below which a Block's particles are
+  /// compressed after particles migrate between Blocks
+  void set_compress_threshold(float compress_threshold)
+  { compress_threshold_ = compress_threshold; }
+
+  /// Return the storage efficiency below which particles are
+  /// compressed after migration, or 0.0 if disabled
+
+  float compress_threshold() const
+  { return compress_threshold_; }
+
+  /// Set the disorder fraction above which particles are sorted
+  void set_sort_threshold(float sort_threshold)
+  { sort_threshold_ = sort_threshold; }
+
+  /// Return the disorder fraction above which particles are sorted,
+  /// or 0.0 if sorting is disabled
+
+  float sort_threshold() const
+  { return sort_threshold_; }
+
   /// Return the batch and particle indices given a global particle
   /// index i.  This is useful e.g. for iterating over a range of
   /// particles, e.g. initializing new particles after insert().
@@ -176,6 +217,11 @@ public: // interface
 
   void index (int i, int * ib, int * ip) const;
 
+  /// Return the batch and particle indices given a global particle
+  /// index i for the given type, using its batch size
+
+  void index (int it, int i, int * ib, int * ip) const;
+
   //--------------------------------------------------
   // GROUPING
   //--------------------------------------------------
@@ -283,6 +329,20 @@ private: // attributes
   /// deallocated, and operated on a batch at a time
 
   int batch_size_;
+
+  /// Per-type batch sizes, or 0 to use batch_size_
+
+  std::vector<int> type_batch_size_;
+
+  /// Fraction of out-of-order particles above which particles are
+  /// sorted by cell; 0.0 disables sorting
+
+  float sort_threshold_;
+
+  /// Storage efficiency below which particles are compressed after
+  /// migration; 0.0 disables compression
+
+  float compress_threshold_;
   
 };
 
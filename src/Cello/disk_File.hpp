@@ -77,6 +77,14 @@ public: // virtual functions
   ( std::string name,  int * type,
     int * m1=0, int * m2=0, int * m3=0, int * m4=0) throw() = 0;
 
+  /// Return whether the dataset exists in the current group
+  virtual bool data_exists (std::string name) throw() = 0;
+
+  /// Open the given 1D dataset for appending, creating it if needed,
+  /// extend it by n elements and select them; return the previous size
+  virtual int data_append
+  ( std::string name, int type, int n) throw() = 0;
+
   /// Select a subset of the data
   virtual void data_slice
   ( int m1, int m2, int m3, int m4,
@@ -145,6 +153,23 @@ public: // virtual functions
   ( const void * buffer, std::string name, int type,
     int n1=1, int n2=0, int n3=0, int n4=0) throw() = 0;
 
+  // Links
+
+  /// Create a link with the given absolute name to an object in
+  /// another file
+  virtual void link_external
+  ( std::string name, std::string file, std::string object) throw() = 0;
+
+  // Dataset layout
+
+  /// Set the compression level (0 for none) and whether to shuffle
+  /// bytes before compressing, for subsequently created datasets
+  virtual void set_compress (int level, bool shuffle = false) throw() = 0;
+
+  /// Set the chunk size of subsequently created datasets, with
+  /// dimensions ordered as in data_create(); 0 for the dataset size
+  virtual void set_chunk (int n1, int n2=0, int n3=0, int n4=0) throw() = 0;
+
 protected: // attributes
 
   /// Path to the file
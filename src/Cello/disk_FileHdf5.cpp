@@ -12,6 +12,9 @@
 #define MAX_DATA_RANK 4
 #define MAX_ATTR_RANK 4
 
+// chunk size in elements of extendable datasets created by data_append()
+#define DATA_APPEND_CHUNK 4096
+
 //----------------------------------------------------------------------
  
 FileHdf5::FileHdf5 (std::string path, std::string name) throw()
@@ -29,18 +32,15 @@ FileHdf5::FileHdf5 (std::string path, std::string name) throw()
     data_name_(""),
     data_type_(type_unknown),
     data_rank_(0),
-    data_prop_(H5P_DEFAULT),
     is_data_open_(false),
-    compress_level_(0)
+    compress_level_(0),
+    compress_shuffle_(false)
 {
   for (int i=0; i<MAX_DATA_RANK; i++) {
     data_dims_[i] = 0;
+    chunk_[i] = 0;
   }
 
-  // data_prop_ = H5P_DEFAULT;
-  // group_prop_ = H5Pcreate (H5P_GROUP_CREATE);
-
-  data_prop_  = H5Pcreate (H5P_DATASET_CREATE);
   group_prop_ = H5P_DEFAULT;
 }
 
@@ -48,7 +48,6 @@ FileHdf5::FileHdf5 (std::string path, std::string name) throw()
 
 FileHdf5::~FileHdf5() throw()
 {
-  H5Pclose (data_prop_);
 }
 
 //----------------------------------------------------------------------
@@ -197,6 +196,98 @@ void FileHdf5::data_open
 
 //----------------------------------------------------------------------
 
+bool FileHdf5::data_exists (std::string name) throw()
+{
+  std::string file_name = path_ + "/" + name_;
+
+  ASSERT1("FileHdf5::data_exists", "Trying to read from unopened file %s",
+	  file_name.c_str(), is_file_open_ );
+
+  hid_t group = (is_group_open_) ? group_id_ : file_id_;
+
+  return H5Lexists (group, name.c_str(), H5P_DEFAULT) > 0;
+}
+
+//----------------------------------------------------------------------
+
+int FileHdf5::data_append
+( std::string name, int type, int n) throw()
+{
+  // error check file open
+
+  std::string file_name = path_ + "/" + name_;
+
+  ASSERT1("FileHdf5::data_append", "Trying to write to unopened file %s",
+	  file_name.c_str(), is_file_open_);
+
+  // Appended datasets are relative to the file root (not the current
+  // group) so that all groups written to the file share them
+
+  if (H5Lexists (file_id_, name.c_str(), H5P_DEFAULT) > 0) {
+
+    data_id_ = open_dataset_(file_id_,name);
+
+  } else {
+
+    // Create an empty chunked dataset with unlimited size
+
+    hsize_t dims[1]    = {0};
+    hsize_t maxdims[1] = {H5S_UNLIMITED};
+    hsize_t chunk[1]   = {DATA_APPEND_CHUNK};
+
+    hid_t space_id = H5Screate_simple (1,dims,maxdims);
+    hid_t prop_id  = H5Pcreate (H5P_DATASET_CREATE);
+    H5Pset_chunk (prop_id,1,chunk);
+    if (compress_shuffle_) H5Pset_shuffle (prop_id);
+    if (compress_level_ > 0) H5Pset_deflate (prop_id,compress_level_);
+
+    data_id_ = H5Dcreate (file_id_,
+			  name.c_str(),
+			  scalar_to_hdf5_(type),
+			  space_id,
+			  H5P_DEFAULT,
+			  prop_id,
+			  H5P_DEFAULT);
+
+    H5Pclose (prop_id);
+    space_close_ (space_id);
+
+    ASSERT2("FileHdf5::data_append", "Return value %d creating dataset %s",
+	    data_id_,name.c_str(), data_id_ >= 0);
+  }
+
+  data_name_ = name;
+  data_type_ = type;
+  is_data_open_ = true;
+
+  // Extend the dataset by n elements
+
+  hid_t space_id = get_data_space_(data_id_,name);
+  hsize_t size = 0;
+  H5Sget_simple_extent_dims (space_id,&size,0);
+  space_close_ (space_id);
+
+  hsize_t size_new = size + n;
+  herr_t retval = H5Dset_extent (data_id_,&size_new);
+
+  ASSERT2("FileHdf5::data_append", "H5Dset_extent() returned %d for %s",
+	  retval,name.c_str(), retval >= 0);
+
+  // Select the appended elements
+
+  data_space_id_ = H5Dget_space (data_id_);
+
+  if (n > 0) {
+    hsize_t start[1] = {size};
+    hsize_t count[1] = {hsize_t(n)};
+    H5Sselect_hyperslab (data_space_id_,H5S_SELECT_SET,start,0,count,0);
+  }
+
+  return int(size);
+}
+
+//----------------------------------------------------------------------
+
 void FileHdf5::data_slice
 ( int m1, int m2, int m3, int m4,
   int n1, int n2, int n3, int n4,
@@ -250,14 +341,18 @@ void FileHdf5::data_create
 
   // Create the new dataset
 
+  hid_t prop_id = data_prop_create_ (data_space_id_);
+
   data_id_ = H5Dcreate( group,
 			name.c_str(),
 			scalar_to_hdf5_(type),
 			data_space_id_,
 			H5P_DEFAULT,
-			data_prop_,
+			prop_id,
 			H5P_DEFAULT);
 
+  H5Pclose (prop_id);
+
   // error check H5Dcreate
 
   ASSERT2("FileHdf5::data_create", "Return value %d creating dataset %s",
@@ -678,19 +773,88 @@ void FileHdf5::group_read_meta
 
 //----------------------------------------------------------------------
 
-void FileHdf5::set_compress (int level) throw ()
+void FileHdf5::link_external
+( std::string name, std::string file, std::string object) throw()
+{
+  // error check file open
+
+  std::string file_name = path_ + "/" + name_;
+
+  ASSERT1("FileHdf5::link_external", "Trying to write to unopened file %s",
+	  file_name.c_str(), is_file_open_);
+
+  // relative target file names are resolved relative to this file
+
+  herr_t retval = H5Lcreate_external
+    (file.c_str(), object.c_str(), file_id_, name.c_str(),
+     H5P_DEFAULT, H5P_DEFAULT);
+
+  ASSERT3("FileHdf5::link_external",
+	  "H5Lcreate_external() returned %d creating link %s to %s",
+	  retval,name.c_str(),file.c_str(), retval >= 0);
+}
+
+//----------------------------------------------------------------------
+
+void FileHdf5::set_compress (int level, bool shuffle) throw ()
 {
-  compress_level_ = level; 
-  if (compress_level_ != 0) {
+  ASSERT1("FileHdf5::set_compress",
+	  "Compression level %d must be between 0 and 9",
+	  level, (0 <= level && level <= 9));
+
+  if (level > 0 && ! H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
     WARNING("FileHdf5::set_compress",
-	    "Hard-coded for 2D data with chunk size [10,10]");
-    int rank = 2;
-    hsize_t chunk_size[MAX_DATA_RANK];
-    chunk_size[0]=10;
-    chunk_size[1]=10;
-    H5Pset_chunk(data_prop_,rank,chunk_size);
-    H5Pset_deflate(data_prop_,compress_level_);
+	    "HDF5 deflate filter unavailable: writing uncompressed data");
+    level = 0;
   }
+
+  compress_level_   = level; 
+  compress_shuffle_ = shuffle;
+}
+
+//----------------------------------------------------------------------
+
+void FileHdf5::set_chunk (int n1, int n2, int n3, int n4) throw ()
+{
+  chunk_[0] = n1;
+  chunk_[1] = n2;
+  chunk_[2] = n3;
+  chunk_[3] = n4;
+}
+
+//----------------------------------------------------------------------
+
+hid_t FileHdf5::data_prop_create_ (hid_t space_id) const throw()
+{
+  hid_t prop_id = H5Pcreate (H5P_DATASET_CREATE);
+
+  const bool is_chunked = (compress_level_ > 0 || compress_shuffle_ ||
+			   chunk_[0] || chunk_[1] || chunk_[2] || chunk_[3]);
+
+  if (is_chunked) {
+
+    hsize_t dims[MAX_DATA_RANK];
+    const int rank = H5Sget_simple_extent_dims(space_id,dims,0);
+
+    // chunks default to the dataset size and may not exceed it
+
+    hsize_t chunk[MAX_DATA_RANK];
+    bool is_empty = false;
+    for (int i=0; i<rank; i++) {
+      chunk[i] = (chunk_[i] > 0) ? std::min(hsize_t(chunk_[i]),dims[i]) : dims[i];
+      if (dims[i] == 0) is_empty = true;
+    }
+
+    // empty datasets remain contiguous
+
+    if (! is_empty) {
+      H5Pset_chunk (prop_id,rank,chunk);
+      if (compress_shuffle_) H5Pset_shuffle (prop_id);
+      if (compress_level_ > 0) H5Pset_deflate (prop_id,compress_level_);
+    }
+  }
+
+  return prop_id;
 }
 
 //======================================================================
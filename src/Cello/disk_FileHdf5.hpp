@@ -47,9 +47,10 @@ public: // interface
     p | data_type_;
     p | data_rank_;
     PUParray(p,data_dims_,4);
-    p | data_prop_;
     p | is_data_open_;
     p | compress_level_;
+    p | compress_shuffle_;
+    PUParray(p,chunk_,4);
   }
 
 public: // virtual functions
@@ -90,6 +91,14 @@ public: // virtual functions
   ( std::string name,  int * type,
     int * m1=0, int * m2=0, int * m3=0, int * m4=0) throw();
 
+  /// Return whether the dataset exists in the current group
+  virtual bool data_exists (std::string name) throw();
+
+  /// Open a 1D dataset for appending, creating it if needed, extend
+  /// it by n elements and select them; return the previous size
+  virtual int data_append
+  ( std::string name, int type, int n) throw();
+
   /// Select a subset of the data
   virtual void data_slice
   ( int m1, int m2, int m3, int m4,
@@ -160,10 +169,22 @@ public: // virtual functions
     int n1=1, int n2=0, int n3=0, int n4=0) throw()
   { write_meta_ ( group_id_, buffer, name, type, n1,n2,n3,n4); }
 
-public: // functions
+  // Links
+
+  /// Create a link with the given absolute name to an object in
+  /// another file
+  virtual void link_external
+  ( std::string name, std::string file, std::string object) throw();
+
+  // Dataset layout
+
+  /// Set the deflate level (0 for none) and shuffle filter
+  virtual void set_compress (int level, bool shuffle = false) throw ();
 
-  /// Set the compression level
-  void set_compress (int level) throw ();
+  /// Set the chunk size (0 for the dataset size)
+  virtual void set_chunk (int n1, int n2=0, int n3=0, int n4=0) throw ();
+
+public: // functions
 
   /// Return the compression level
   int compress () throw () {return compress_level_; }
@@ -224,6 +245,10 @@ private: // functions
   /// Close the dataset
   void close_dataset_ () throw();
 
+  /// Return a dataset creation property list with the chunking and
+  /// filters set for a dataset with the given dataspace
+  hid_t data_prop_create_ (hid_t space_id) const throw();
+
 private: // attributes
 
   /// HDF5 file descriptor
@@ -271,15 +296,18 @@ private: // attributes
   /// Dataset size
   hsize_t data_dims_[4];
 
-  /// HDF5 dataset property list
-  hid_t data_prop_;
-
   /// Whether a dataset is open or closed
   bool  is_data_open_;
 
   /// Compression level
   int compress_level_;
 
+  /// Whether to shuffle bytes before compression
+  bool compress_shuffle_;
+
+  /// Chunk size of created datasets, 0 for the dataset size
+  int chunk_[4];
+
 };
 
 #endif /* DISK_FILE_HDF5_HPP */
@@ -128,59 +128,148 @@ void InputData::read_field( Block * block, int index_field) throw()
   io_field_data()->set_field_data(field.field_data());
   io_field_data()->set_field_index(index_field);
 
+  file_->group_chdir("/" + block->name());
+  file_->group_open();
+
   for (size_t i=0; i<io_field_data()->data_count(); i++) {
 
-    void * buffer = 0;
+    void * buffer;
     std::string name;
     int type;
     int nxd,nyd,nzd;  // Array dimension
     int nx,ny,nz;     // Array size
 
-    // Read ith FieldData data
-
-    file_->data_open(name.c_str(),&type,&nx,&ny,&nz);
-    file_->data_read(buffer);
-    file_->data_close();
-
     // Get ith FieldData data
     io_field_data()->field_array(i, &buffer, &name, &type, 
 				 &nxd,&nyd,&nzd,
 				 &nx, &ny, &nz);
 
+    // Read ith FieldData data, if the field was written
+
+    if (! file_->data_exists(name)) continue;
+
+    int type_file;
+    int m1=1,m2=1,m3=1;
+    file_->data_open(name,&type_file,&m1,&m2,&m3);
+
+    ASSERT1 ("InputData::read_field()",
+	     "Dataset %s type differs from the field precision",
+	     name.c_str(),
+	     type_file == type);
+
+    ASSERT5 ("InputData::read_field()",
+	     "Dataset %s size %d differs from field size (%d %d %d)",
+	     name.c_str(),m1*m2*m3,nx,ny,nz,
+	     m1*m2*m3 == nx*ny*nz);
+
+    file_->mem_create(nx,ny,nz,nx,ny,nz,0,0,0);
+    file_->data_read(buffer);
+    file_->mem_close();
+    file_->data_close();
+
   }
 
+  file_->group_close();
+  file_->group_chdir("/");
 }
 
 //----------------------------------------------------------------------
 
 void InputData::read_particle
-( Block * block, int index_particle) throw()
+( Block * block, int it) throw()
 {
-  // io_particle_data()->set_particle_descr((ParticleDescr*)particle_descr);
-  // io_particle_data()->set_particle_data(particle_data);
-  // io_particle_data()->set_particle_index(index_particle);
+  // Particles are either in the Block group's own datasets, or if
+  // written with Output:particle_layout = "concatenate", the Block
+  // group's offset and count attributes index the file's
+  // concatenated particle datasets
+
+  Particle particle = block->data()->particle();
 
-  // for (size_t i=0; i<io_particle_data()->data_count(); i++) {
+  const std::string prefix = "particle_" + particle.type_name(it);
 
-  //   void * buffer = 0;
-  //   std::string name;
-  //   int type;
-  //   int nxd,nyd,nzd;  // Array dimension
-  //   int nx,ny,nz;     // Array size
+  const int na = particle.num_attributes(it);
 
-  //   // Read ith ParticleData data
+  if (na == 0) return;
 
-  //   file_->data_open(name.c_str(),&type,&nx,&ny,&nz);
-  //   file_->data_read(buffer);
-  //   file_->data_close();
+  int offset = 0;
+  int np = 0;
+  int type;
 
-  //   // Get ith ParticleData data
-  //   io_particle_data()->field_array(i, &buffer, &name, &type, 
-  //                                   &nxd,&nyd,&nzd,
-  // 				       &nx, &ny, &nz);
+  file_->group_chdir("/" + block->name());
+  file_->group_open();
 
-  // }
+  const bool in_group =
+    file_->data_exists(prefix + "_" + particle.attribute_name(it,0));
 
+  if (in_group) {
+    file_->data_open(prefix + "_" + particle.attribute_name(it,0),
+		     &type,&np);
+    file_->data_close();
+  } else {
+    file_->group_read_meta(&offset,prefix + "_offset",&type);
+    file_->group_read_meta(&np,    prefix + "_count", &type);
+    file_->group_close();
+    file_->group_chdir("/");
+  }
+
+  if (np > 0) {
+
+    ASSERT1 ("InputData::read_particle()",
+	     "Particle type %s must not be interleaved",
+	     particle.type_name(it).c_str(),
+	     ! particle.interleaved(it));
+
+    // batch and index of the first inserted particle
+
+    const int i0 = particle.insert_particles (it,np);
+
+    int ib0,ip0;
+    particle.index(it,i0,&ib0,&ip0);
+
+    for (int ia=0; ia<na; ia++) {
+
+      const std::string name = prefix + "_" + particle.attribute_name(it,ia);
+      const int bytes = particle.attribute_bytes(it,ia);
+
+      int mp;
+      file_->data_open(name,&type,&mp);
+
+      ASSERT1 ("InputData::read_particle()",
+	       "Dataset %s type differs from the particle attribute type",
+	       name.c_str(),
+	       type == particle.attribute_type(it,ia));
+
+      ASSERT4 ("InputData::read_particle()",
+	       "Particles [%d,%d) out of range of %d in dataset %s",
+	       offset,offset+np,mp,name.c_str(),
+	       offset + np <= mp);
+
+      // read into each batch from the range inserted
+
+      int ib = ib0;
+      int ip = ip0;
+      for (int i=0; i<np; ) {
+	const int mb = std::min(np - i, particle.num_particles(it,ib) - ip);
+	file_->data_slice
+	  (mp, 1, 1, 1,
+	   mb, 1, 1, 1,
+	   offset+i, 0, 0, 0);
+	file_->mem_create(mb,1,1,mb,1,1,0,0,0);
+	file_->data_read(particle.attribute_array(it,ia,ib) + ip*bytes);
+	file_->mem_close();
+	i += mb;
+	ib++;
+	ip = 0;
+      }
+
+      file_->data_close();
+    }
+  }
+
+  if (in_group) {
+    file_->group_close();
+    file_->group_chdir("/");
+  }
 }
 
 //======================================================================
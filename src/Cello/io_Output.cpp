@@ -30,8 +30,7 @@ Output::Output (int index, const Factory * factory) throw()
     io_field_data_(0),
     it_particle_index_(0),        // set_it_index_particle()
     io_particle_data_(0),
-    stride_write_(1), // default one file per process
-    stride_wait_(1) // default all can write at once
+    stride_write_(1) // default one file per process
 
 {
   io_block_         = factory->create_io_block();
@@ -86,7 +85,6 @@ void Output::pup (PUP::er &p)
   if (up) io_particle_data_ = new IoParticleData;
   p | *io_particle_data_;
   p | stride_write_;
-  p | stride_wait_;
 
 }
 
@@ -58,8 +58,7 @@ public: // functions
       io_field_data_(0),
       it_particle_index_(0),        // set_it_index_particle()
       io_particle_data_(0),
-      stride_write_(1),// default one file per process
-      stride_wait_(0) // default no synchronization of writes
+      stride_write_(1) // default one file per process
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -124,9 +123,6 @@ public: // functions
   int stride_write () const throw () 
   { return stride_write_; }
 
-  int stride_wait () const throw () 
-  { return stride_wait_; }
-
   /// Return whether this process is a writer
   bool is_writer () const throw () 
   { return (CkMyPe() == process_writer()); }
@@ -138,6 +134,30 @@ public: // functions
     return ip - (ip % stride_write_);
   }
 
+  /// Whether data are combined along a binomial tree of processes
+  /// rooted at the writer instead of sent directly to the writer
+  virtual bool is_tree_reduce () const throw()
+  { return false; }
+
+  /// Return the parent of this process in the binomial tree rooted
+  /// at the writer
+  int process_parent() const throw()
+  {
+    const int ip = CkMyPe() - process_writer();
+    return process_writer() + (ip & (ip - 1));
+  }
+
+  /// Return the number of children of this process in the binomial
+  /// tree rooted at the writer
+  int num_children() const throw()
+  {
+    const int ip = CkMyPe() - process_writer();
+    const int np = std::min(stride_write_, CkNumPes() - process_writer());
+    int n = 0;
+    for (int k=1; (ip & k) == 0 && ip + k < np; k <<= 1) n++;
+    return n;
+  }
+
   /// Return the updated timestep if time + dt goes past a scheduled output
   double update_timestep (double time, double dt) const throw ();
 
@@ -221,6 +241,27 @@ public: // virtual functions
   virtual void cleanup_remote (int * n, char ** buffer) throw()
   {}
 
+  /// Whether the root process writes a shared file indexing all Blocks
+  virtual bool is_linked () const throw()
+  { return false; }
+
+  /// Return local Block entries for the shared link file
+  virtual std::string link_entries () const throw()
+  { return ""; }
+
+  /// Write the shared link file given all processes' entries (root only)
+  virtual void write_link (const std::string & entries) throw()
+  {}
+
+  /// Write the next Block staged for asynchronous output after
+  /// close(), if any, and return whether any remain
+  virtual bool write_staged () throw()
+  { return false; }
+
+  /// Write all Blocks still staged for asynchronous output
+  void flush () throw()
+  { while (write_staged()) ; }
+
 protected:
 
   /// Return the name for the format and given arguments
@@ -320,8 +361,6 @@ protected: // attributes
   /// Only processes with id's divisible by stride_write_ writes
   /// (1: all processes write; 2: 0,2,4,... write; np: root process writes)
   int stride_write_;
-  
-  int stride_wait_;
 
 };
 
@@ -18,12 +18,11 @@ OutputCheckpoint::OutputCheckpoint
  int process_count
 ) throw ()
   : Output(index,factory),
-    restart_file_("")
+    restart_file_(""),
+    memory_(false)
 {
 
   set_stride_write (process_count);
-  
-  stride_wait_ = 1;
 
   TRACE1 ("index = %d",index_);
   TRACE2 ("config->output_dir[%d]=%p",index_,&config->output_dir[index_]);
@@ -32,6 +31,16 @@ OutputCheckpoint::OutputCheckpoint
 
   restart_file_ = config->restart_file;
 
+  memory_ = config->output_memory[index_];
+
+#if ! CMK_MEM_CHECKPOINT
+  if (memory_) {
+    WARNING1("OutputCheckpoint::OutputCheckpoint()",
+	     "Output %d: memory checkpoints are skipped since Charm++ "
+	     "was not built with the syncft option",
+	     int(index_));
+  }
+#endif
 }
 
 
@@ -45,6 +54,7 @@ void OutputCheckpoint::pup (PUP::er &p)
   Output::pup(p);
 
   p | restart_file_;
+  p | memory_;
 
   Simulation * simulation = cello::simulation();
   const bool l_unpacking = p.isUnpacking();
@@ -86,11 +96,19 @@ void OutputCheckpoint::write_simulation ( const Simulation * simulation ) throw(
 {
   TRACE("OutputCheckpoint::write_simulation()");
 
-  std::string dir_name = expand_name_(&dir_name_,&dir_args_);
-
   simulation->set_phase (phase_restart);
 
-  proxy_main.p_checkpoint(CkNumPes(),dir_name);
+  if (memory_) {
+
+    proxy_main.p_checkpoint_memory(CkNumPes());
+
+  } else {
+
+    std::string dir_name = expand_name_(&dir_name_,&dir_args_);
+
+    proxy_main.p_checkpoint(CkNumPes(),dir_name);
+
+  }
 
 }
 
@@ -17,7 +17,10 @@ class OutputCheckpoint : public Output {
 public: // functions
 
   /// Empty constructor for Charm++ pup()
-  OutputCheckpoint() throw() { }
+  OutputCheckpoint() throw()
+    : restart_file_(""),
+      memory_(false)
+  { }
 
   /// Create an uninitialized OutputCheckpoint object
   OutputCheckpoint(int index, 
@@ -32,7 +35,11 @@ public: // functions
   PUPable_decl(OutputCheckpoint);
 
   /// Charm++ PUP::able migration constructor
-  OutputCheckpoint (CkMigrateMessage *m) : Output (m) { }
+  OutputCheckpoint (CkMigrateMessage *m)
+    : Output (m),
+      restart_file_(""),
+      memory_(false)
+  { }
 
   /// CHARM++ Pack / Unpack function
   void pup (PUP::er &p);
@@ -73,6 +80,10 @@ private: // private functions
   /// Name of parameter file to read on restart for updated parameters
   std::string restart_file_;
 
+  /// Whether to checkpoint to the memory of each process and a buddy
+  /// process instead of to disk
+  bool memory_;
+
 };
 
 #endif /* IO_OUTPUT_CHECKPOINT_HPP */
@@ -21,7 +21,33 @@ OutputData::OutputData
  Config * config
 ) throw ()
   : Output(index,factory),
-    text_block_count_(0)
+    text_block_count_(0),
+    particle_concatenate_(false),
+    field_aggregate_(false),
+    link_name_(""),
+    link_args_(),
+    block_names_(),
+    async_(false),
+    async_max_bytes_(0),
+    staged_(),
+    staged_bytes_(0),
+    file_staged_(0),
+    compress_level_(0),
+    compress_shuffle_(false),
+    chunk_size_(),
+    field_compress_level_(),
+    aggregate_fields_(),
+    aggregate_index_(),
+    aggregate_level_(),
+    aggregate_lower_(),
+    aggregate_upper_(),
+    aggregate_particle_offset_(),
+    aggregate_particle_count_(),
+    incremental_(false),
+    full_interval_(1),
+    block_hash_(),
+    block_file_(),
+    block_current_()
 {
   // Set process stride, with default = 1
 
@@ -30,16 +56,71 @@ OutputData::OutputData
 #ifdef TRACE_OUTPUT  
   CkPrintf ("%d TRACE_OUTPUT output_stride_write = %d\n",CkMyPe(),
 	    config->output_stride_write[index_]);
-  CkPrintf ("%d TRACE_OUTPUT output_stride_wait = %d\n",CkMyPe(),
-	    config->output_stride_wait[index_]);
 #endif  
 
   stride = config->output_stride_write[index_];
   set_stride_write ((stride == 0) ? 1 : stride);
   
-  stride = config->output_stride_wait[index_];
-  stride_wait_ = (stride == 0) ? 1 : stride;
+  particle_concatenate_ =
+    (config->output_particle_layout[index_] == "concatenate");
 
+  // aggregated fields have no Block groups, so particles are
+  // concatenated and indexed by the Block index table
+
+  field_aggregate_ = (config->output_field_layout[index_] == "aggregate");
+
+  if (field_aggregate_) particle_concatenate_ = true;
+
+  // Shared link file name, if any
+
+  const std::vector<std::string> & link_name = config->output_link_name[index_];
+  if (link_name.size() > 0) {
+    link_name_ = link_name[0];
+    link_args_.assign(link_name.begin()+1,link_name.end());
+  }
+
+  async_ = config->output_async[index_];
+
+  if (async_ && field_aggregate_) {
+    WARNING1("OutputData::OutputData()",
+	     "Output %d: async is ignored with field_layout \"aggregate\"",
+	     int(index_));
+    async_ = false;
+  }
+  async_max_bytes_ = (int64_t) (config->output_async_max_mb[index_]*1024*1024);
+
+  // HDF5 dataset layout
+
+  compress_level_   = config->output_compress_level[index_];
+  compress_shuffle_ = config->output_compress_shuffle[index_];
+  chunk_size_       = config->output_chunk_size[index_];
+
+  for (int i=0; i<config->num_fields; i++) {
+    if (config->field_compress_level[i] >= 0) {
+      const std::string name = "field_" + config->field_list[i];
+      field_compress_level_[name] = config->field_compress_level[i];
+    }
+  }
+
+  // Incremental output: unchanged Blocks' data are referenced in the
+  // block list, so the "block" layouts and a directory are required
+
+  incremental_   = config->output_incremental[index_];
+  full_interval_ = config->output_full_interval[index_];
+
+  if (incremental_ && (field_aggregate_ || particle_concatenate_)) {
+    WARNING1("OutputData::OutputData()",
+	     "Output %d: incremental requires field_layout and "
+	     "particle_layout \"block\"",
+	     int(index_));
+    incremental_ = false;
+  }
+  if (incremental_ && config->output_dir[index_].size() == 0) {
+    WARNING1("OutputData::OutputData()",
+	     "Output %d: incremental requires dir to be set",
+	     int(index_));
+    incremental_ = false;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -47,6 +128,7 @@ OutputData::OutputData
 OutputData::~OutputData() throw()
 {
   close();
+  flush();
 }
 
 //----------------------------------------------------------------------
@@ -60,7 +142,26 @@ void OutputData::pup (PUP::er &p)
 
   Output::pup(p);
 
+  // staged Blocks are written before packing rather than pupped
+
+  if (! p.isUnpacking()) flush();
+
   p | text_block_count_;
+  p | particle_concatenate_;
+  p | field_aggregate_;
+  p | link_name_;
+  p | link_args_;
+  p | block_names_;
+  p | async_;
+  p | async_max_bytes_;
+  p | compress_level_;
+  p | compress_shuffle_;
+  p | chunk_size_;
+  p | field_compress_level_;
+  p | incremental_;
+  p | full_interval_;
+  p | block_hash_;
+  p | block_file_;
 }
 
 //======================================================================
@@ -70,6 +171,10 @@ void OutputData::open () throw()
 #ifdef TRACE_OUTPUT
     CkPrintf ("%d TRACE_OUTPUT OutputData::open()\n",CkMyPe());
 #endif    
+  // complete the previous output's file before starting the next
+
+  flush();
+
   std::string file_name = expand_name_(&file_name_,&file_args_);
 
   std::string dir = directory();
@@ -81,6 +186,8 @@ void OutputData::open () throw()
   file_ = new FileHdf5 (dir,file_name);
 
   file_->file_create();
+
+  block_names_.clear();
 }
 
 //----------------------------------------------------------------------
@@ -90,8 +197,35 @@ void OutputData::close () throw()
 #ifdef TRACE_OUTPUT
     CkPrintf ("%d TRACE_OUTPUT OutputData::close()\n",CkMyPe());
 #endif    
-  if (file_) file_->file_close();
-  delete file_;  file_ = 0;
+  if (file_ && field_aggregate_) write_aggregate_(file_);
+
+  // forget Blocks that were refined, coarsened, or migrated away
+
+  if (incremental_) {
+    std::map<std::string,uint64_t>::iterator it = block_hash_.begin();
+    while (it != block_hash_.end()) {
+      if (block_current_.count(it->first) == 0) {
+	block_file_.erase(it->first);
+	block_hash_.erase(it++);
+      } else {
+	++it;
+      }
+    }
+    block_current_.clear();
+  }
+
+  if (file_ && ! staged_.empty()) {
+
+    // keep the file open for writing staged Blocks later
+
+    file_staged_ = file_;
+    file_ = 0;
+
+  } else {
+
+    if (file_) file_->file_close();
+    delete file_;  file_ = 0;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -127,17 +261,18 @@ void OutputData::write_block (  const Block * block ) throw()
     CkPrintf ("%d TRACE_OUTPUT OutputData::write_block()\n",CkMyPe());
 #endif    
 
-  char file[256];
-  char dir[256];
-  char line[256];
-
   std::string name_dir = expand_name_(&dir_name_,&dir_args_);
+  std::string name_file  = expand_name_(&file_name_,&file_args_);
+
+  // File already holding the Block's data if unchanged
+
+  const std::string file_data = (incremental_ && name_dir != "") ?
+    file_unchanged_(block,name_dir,name_file) : "";
 
   // Write blocks text file
   
   if (name_dir != "") {
 
-    std::string name_file  = expand_name_(&file_name_,&file_args_);
     const int num_blocks = cello::hierarchy()->num_blocks();
     int count = 0;
     
@@ -154,13 +289,18 @@ void OutputData::write_block (  const Block * block ) throw()
     
     count = (text_block_count_ == 0) ? num_blocks : 0;
     
-    sprintf (file,"%s.block_list",name_dir.c_str());
-    sprintf (dir, "%s",           name_dir.c_str());
-    sprintf (line,"%s %s\n",      block->name().c_str(),name_file.c_str());
-    
-    proxy_main.p_text_file_write(strlen(dir)+1, dir,
-				 strlen(file)+1, file,
-				 strlen(line)+1,line,
+    // Block names and file paths have no length limit, so the lines
+    // are built as strings rather than in fixed-size buffers
+
+    std::string dir  = name_dir;
+    std::string file = name_dir + ".block_list";
+    std::string line = block->name() + " " + name_file;
+    if (file_data != "") line = line + " " + file_data;
+    line = line + "\n";
+
+    proxy_main.p_text_file_write(dir.size()+1,  dir.c_str(),
+				 file.size()+1, file.c_str(),
+				 line.size()+1, line.c_str(),
 				 count);
     
     // Contribute to DIR.file_list file
@@ -169,13 +309,12 @@ void OutputData::write_block (  const Block * block ) throw()
       
       count = 0;
     
-      sprintf (file,"%s.file_list",name_dir.c_str());
-      sprintf (dir, "%s",          name_dir.c_str());
-      sprintf (line,"%s\n",        name_file.c_str());
-    
-      proxy_main.p_text_file_write(strlen(dir)+1, dir,
-				   strlen(file)+1, file,
-				   strlen(line)+1,line,
+      file = name_dir + ".file_list";
+      line = name_file + "\n";
+
+      proxy_main.p_text_file_write(dir.size()+1,  dir.c_str(),
+				   file.size()+1, file.c_str(),
+				   line.size()+1, line.c_str(),
 				   count);
     }    
 
@@ -185,6 +324,37 @@ void OutputData::write_block (  const Block * block ) throw()
 
   }
 
+  if (is_linked()) block_names_.push_back(block->name());
+
+  if (field_aggregate_) {
+    aggregate_block_(block);
+    return;
+  }
+
+  // Write only the meta data of unchanged Blocks, whose fields and
+  // particles are read from file_data on restart
+
+  if (file_data != "") {
+    file_->group_chdir("/" + block->name());
+    file_->group_create();
+    io_block()->set_block((Block *)block);
+    write_meta_group (io_block());
+    file_->group_close();
+    return;
+  }
+
+  // Copy the Block to the staging buffer if it fits, to be written
+  // by write_staged() after close()
+
+  if (async_) {
+    const int64_t bytes = staged_bytes_block_(block);
+    if (staged_bytes_ + bytes <= async_max_bytes_) {
+      stage_block_(block);
+      staged_bytes_ += bytes;
+      return;
+    }
+  }
+
   // Create file group for block
 
   std::string group_name = "/" + block->name();
@@ -209,6 +379,427 @@ void OutputData::write_block (  const Block * block ) throw()
 
 //----------------------------------------------------------------------
 
+std::string OutputData::link_entries () const throw()
+{
+  // one "index link name file object" line per local Block group, or
+  // per file for aggregated fields
+
+  const std::string link = directory() + "/" + 
+    expand_name_(&link_name_,&link_args_);
+  const std::string file = expand_name_(&file_name_,&file_args_);
+
+  char index[20];
+  sprintf (index,"%d",int(index_));
+
+  std::string entries = "";
+  if (field_aggregate_) {
+    if (block_names_.size() > 0) {
+      entries = entries + index + " " + link + " " 
+	+       file + " " + file + " /\n";
+    }
+  } else {
+    for (size_t i=0; i<block_names_.size(); i++) {
+      entries = entries + index + " " + link + " " 
+	+       block_names_[i] + " " + file + " /" + block_names_[i] + "\n";
+    }
+  }
+  return entries;
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::write_link (const std::string & entries) throw()
+{
+  std::istringstream stream (entries);
+
+  std::string index, link, name, file, object;
+
+  FileHdf5 * file_link = NULL;
+
+  while (stream >> index >> link >> name >> file >> object) {
+
+    if (file_link == NULL) {
+
+      // link file path is "dir/name"; target files are in the same
+      // directory, so external links use names relative to it
+
+      const size_t pos = link.rfind("/");
+      const std::string dir  = link.substr(0,pos);
+      const std::string name = link.substr(pos+1);
+
+      Monitor::instance()->print 
+	("Output","writing link file %s", link.c_str());
+
+      file_link = new FileHdf5 (dir,name);
+      file_link->file_create();
+    }
+
+    file_link->link_external ("/" + name, file, object);
+  }
+
+  if (file_link) {
+    file_link->file_close();
+    delete file_link;
+  }
+}
+
+//----------------------------------------------------------------------
+
+bool OutputData::write_staged () throw()
+{
+  if (file_staged_ == NULL) return false;
+
+  if (! staged_.empty()) {
+
+    StagedBlock * staged = staged_.front();
+    staged_.pop_front();
+
+    File * file = file_staged_;
+
+    file->group_chdir("/" + staged->name);
+    file->group_create();
+
+    for (size_t i=0; i<staged->meta.size(); i++) {
+      const StagedArray & meta = staged->meta[i];
+      file->group_write_meta((void *)&meta.values[0],meta.name.c_str(),
+			     meta.type,meta.nx,meta.ny,meta.nz);
+    }
+
+    for (size_t i=0; i<staged->fields.size(); i++) {
+      const StagedArray & field = staged->fields[i];
+      write_field_array_ (file,field.name,field.type,&field.values[0],
+			  field.nxd,field.nyd,field.nzd,
+			  field.nx, field.ny, field.nz);
+    }
+
+    for (size_t it=0; it<staged->particles.size(); it++) {
+      const StagedParticles & particles = staged->particles[it];
+      const int np = particles.np;
+      int offset = 0;
+      for (size_t ia=0; ia<particles.attributes.size(); ia++) {
+	const StagedArray & attribute = particles.attributes[ia];
+	std::vector<const void *> batch_array;
+	std::vector<int>          batch_count;
+	if (np > 0) {
+	  batch_array.push_back(&attribute.values[0]);
+	  batch_count.push_back(np);
+	}
+	offset = write_particle_attribute_
+	  (file,attribute.name,attribute.type,np,batch_array,batch_count);
+      }
+      if (particle_concatenate_) {
+	write_particle_index_(file,particles.type_name,offset,np);
+      }
+    }
+
+    file->group_close();
+
+    delete staged;
+  }
+
+  if (staged_.empty()) {
+
+    file_staged_->file_close();
+    delete file_staged_;
+    file_staged_ = 0;
+    staged_bytes_ = 0;
+
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+
+int64_t OutputData::staged_bytes_block_ (const Block * block) throw()
+{
+  int64_t bytes = 0;
+
+  ItIndex * it_f = it_field_index_;
+  if (it_f) {
+    FieldData * field_data = (FieldData *) block->data()->field_data();
+    io_field_data()->set_field_data(field_data);
+    for (it_f->first(); ! it_f->done();  it_f->next()  ) {
+      io_field_data()->set_field_index(it_f->value());
+      int type;
+      int nx,ny,nz;
+      io_field_data()->field_array(0, NULL, NULL, &type, 
+				   NULL,NULL,NULL, &nx,&ny,&nz);
+      bytes += (int64_t) cello::sizeof_type(type)*nx*ny*nz;
+    }
+  }
+
+  ItIndex * it_p = it_particle_index_;
+  if (it_p) {
+    Particle particle = ((Block *)block)->data()->particle();
+    for (it_p->first(); ! it_p->done();  it_p->next()  ) {
+      const int it = it_p->value();
+      const int na = particle.num_attributes(it);
+      const int np = particle.num_particles(it);
+      for (int ia=0; ia<na; ia++) {
+	bytes += (int64_t) particle.attribute_bytes(it,ia)*np;
+      }
+    }
+  }
+
+  return bytes;
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::stage_block_ (const Block * block) throw()
+{
+  // attribute staging memory to the "Output" Memory group, whose limit
+  // is the staging budget
+
+#ifdef CONFIG_USE_MEMORY
+  Memory * memory = Memory::instance();
+  if (memory->index_group("Output") == 0) {
+    memory->new_group("Output");
+    memory->set_bytes_limit(async_max_bytes_,"Output");
+  }
+  std::string group = memory->group();
+  memory->set_group("Output");
+#endif
+
+  StagedBlock * staged = new StagedBlock;
+
+  staged->name = block->name();
+
+  // Copy Block meta data
+
+  io_block()->set_block((Block *)block);
+
+  staged->meta.resize(io_block()->meta_count());
+  for (size_t i=0; i<io_block()->meta_count(); i++) {
+    StagedArray & meta = staged->meta[i];
+    void * buffer;
+    io_block()->meta_value(i,&buffer,&meta.name,&meta.type,
+			   &meta.nx,&meta.ny,&meta.nz);
+    meta.nxd = meta.nx;
+    meta.nyd = meta.ny;
+    meta.nzd = meta.nz;
+    // unused dimensions are 0
+    const int bytes = cello::sizeof_type(meta.type)*meta.nx
+      *                std::max(meta.ny,1)*std::max(meta.nz,1);
+    meta.values.assign((char *)buffer,(char *)buffer + bytes);
+  }
+
+  // Copy fields
+
+  ItIndex * it_f = it_field_index_;
+  if (it_f) {
+    FieldData * field_data = (FieldData *) block->data()->field_data();
+    io_field_data()->set_field_data(field_data);
+    for (it_f->first(); ! it_f->done();  it_f->next()  ) {
+      io_field_data()->set_field_index(it_f->value());
+      staged->fields.push_back(StagedArray());
+      StagedArray & field = staged->fields.back();
+      void * buffer;
+      io_field_data()->field_array(0, &buffer, &field.name, &field.type, 
+				   &field.nxd,&field.nyd,&field.nzd,
+				   &field.nx, &field.ny, &field.nz);
+      const int bytes = 
+	cello::sizeof_type(field.type)*field.nx*field.ny*field.nz;
+      field.values.assign((char *)buffer,(char *)buffer + bytes);
+    }
+  }
+
+  // Copy particles, concatenating batches
+
+  ItIndex * it_p = it_particle_index_;
+  if (it_p) {
+    Particle particle = ((Block *)block)->data()->particle();
+    for (it_p->first(); ! it_p->done();  it_p->next()  ) {
+      const int it = it_p->value();
+      const int na = particle.num_attributes(it);
+      const int nb = particle.num_batches(it);
+      const int np = particle.num_particles(it);
+      staged->particles.push_back(StagedParticles());
+      StagedParticles & particles = staged->particles.back();
+      particles.type_name = particle.type_name(it);
+      particles.np = np;
+      particles.attributes.resize(na);
+      for (int ia=0; ia<na; ia++) {
+	StagedArray & attribute = particles.attributes[ia];
+	const int bytes = particle.attribute_bytes(it,ia);
+	attribute.name = "particle_" + particle.type_name(it) + "_"
+	  +               particle.attribute_name(it,ia);
+	attribute.type = particle.attribute_type(it,ia);
+	attribute.nxd = attribute.nx = np;
+	attribute.nyd = attribute.ny = 1;
+	attribute.nzd = attribute.nz = 1;
+	attribute.values.reserve(bytes*np);
+	for (int ib=0; ib<nb; ib++) {
+	  const char * array = particle.attribute_array(it,ia,ib);
+	  const int mb = particle.num_particles(it,ib);
+	  attribute.values.insert(attribute.values.end(),array,array+bytes*mb);
+	}
+      }
+    }
+  }
+
+  staged_.push_back(staged);
+
+#ifdef CONFIG_USE_MEMORY
+  memory->set_group(group);
+#endif
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::aggregate_block_ (const Block * block) throw()
+{
+  // Append Block index table entries
+
+  int v3[3];
+  block->index().values(v3);
+  aggregate_index_.insert(aggregate_index_.end(),v3,v3+3);
+  aggregate_level_.push_back(block->level());
+
+  double lower[3],upper[3];
+  block->lower(&lower[0],&lower[1],&lower[2]);
+  block->upper(&upper[0],&upper[1],&upper[2]);
+  aggregate_lower_.insert(aggregate_lower_.end(),lower,lower+3);
+  aggregate_upper_.insert(aggregate_upper_.end(),upper,upper+3);
+
+  // Append fields, which have the same size in all Blocks
+
+  ItIndex * it_f = it_field_index_;
+  if (it_f) {
+    FieldData * field_data = (FieldData *) block->data()->field_data();
+    io_field_data()->set_field_data(field_data);
+    size_t k = 0;
+    for (it_f->first(); ! it_f->done();  it_f->next(), k++  ) {
+      io_field_data()->set_field_index(it_f->value());
+      if (k == aggregate_fields_.size()) {
+	aggregate_fields_.push_back(StagedArray());
+      }
+      StagedArray & field = aggregate_fields_[k];
+      void * buffer;
+      std::string name;
+      int type;
+      int nxd,nyd,nzd;
+      int nx,ny,nz;
+      io_field_data()->field_array(0, &buffer, &name, &type, 
+				   &nxd,&nyd,&nzd, &nx,&ny,&nz);
+      if (field.values.empty()) {
+	field.name = name;
+	field.type = type;
+	field.nxd = nxd;  field.nyd = nyd;  field.nzd = nzd;
+	field.nx  = nx;   field.ny  = ny;   field.nz  = nz;
+      }
+      ASSERT7 ("OutputData::aggregate_block_()",
+	       "Field %s size (%d %d %d) differs from aggregated size (%d %d %d)",
+	       name.c_str(),nx,ny,nz,field.nx,field.ny,field.nz,
+	       (name == field.name &&
+		nx == field.nx && ny == field.ny && nz == field.nz));
+      const size_t bytes = size_t(cello::sizeof_type(type))*nx*ny*nz;
+      field.values.insert(field.values.end(),
+			  (char *)buffer,(char *)buffer + bytes);
+    }
+  }
+
+  // Append particles to the file's concatenated datasets
+
+  ItIndex * it_p = it_particle_index_;
+  if (it_p) {
+    const ParticleData * particle_data = block->data()->particle_data();
+    for (it_p->first(); ! it_p->done();  it_p->next()  ) {
+      write_particle_data (particle_data, it_p->value());
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::write_aggregate_ (File * file) throw()
+{
+  const int nb = aggregate_level_.size();
+
+  if (nb > 0) {
+
+    // Block index table
+
+    file->set_compress(0);
+    file->set_chunk(0);
+
+    write_table_(file,"block_index",type_int32, nb,3,&aggregate_index_[0]);
+    write_table_(file,"block_level",type_int32, nb,1,&aggregate_level_[0]);
+    write_table_(file,"block_lower",type_double,nb,3,&aggregate_lower_[0]);
+    write_table_(file,"block_upper",type_double,nb,3,&aggregate_upper_[0]);
+
+    std::map<std::string, std::vector<int> >::iterator it;
+    for (it =  aggregate_particle_offset_.begin();
+	 it != aggregate_particle_offset_.end(); ++it) {
+      const std::string prefix = "particle_" + it->first;
+      write_table_(file,prefix + "_offset",type_int32,nb,1,
+		   &aggregate_particle_offset_[it->first][0]);
+      write_table_(file,prefix + "_count",type_int32,nb,1,
+		   &aggregate_particle_count_[it->first][0]);
+    }
+
+    // One [block][z][y][x] dataset and one write per field
+
+    for (size_t k=0; k<aggregate_fields_.size(); k++) {
+
+      const StagedArray & field = aggregate_fields_[k];
+
+      // nb*nx*ny*nz may exceed INT_MAX, so describe memory as
+      // [block][cell] rather than as one flat dimension
+
+      const int nc = field.nx*field.ny*field.nz;
+
+      set_field_layout_ (file,field.name,field.nxd,field.nyd,field.nzd,true);
+
+      file->mem_create(nc,nb,1,nc,nb,1,0,0,0);
+      if (field.nzd > 1) {
+	file->data_create(field.name.c_str(),field.type,
+			  nb,field.nzd,field.nyd,field.nxd,
+			  nb,field.nz, field.ny, field.nx);
+      } else if (field.nyd > 1) {
+	file->data_create(field.name.c_str(),field.type,
+			  nb,field.nyd,field.nxd,1,
+			  nb,field.ny, field.nx, 1);
+      } else {
+	file->data_create(field.name.c_str(),field.type,
+			  nb,field.nxd,1,1,
+			  nb,field.nx, 1,1);
+      }
+      file->data_write((void *)&field.values[0]);
+      file->mem_close();
+      file->data_close();
+    }
+  }
+
+  // release aggregated arrays
+
+  std::vector<StagedArray>().swap(aggregate_fields_);
+  aggregate_index_.clear();
+  aggregate_level_.clear();
+  aggregate_lower_.clear();
+  aggregate_upper_.clear();
+  aggregate_particle_offset_.clear();
+  aggregate_particle_count_.clear();
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::write_table_
+(File * file, const std::string & name, int type, int n1, int n2,
+ const void * buffer) throw()
+{
+  const int n = n1*n2;
+  file->mem_create(n,1,1,n,1,1,0,0,0);
+  file->data_create(name.c_str(),type,n1,n2,1,1);
+  file->data_write((void *)buffer);
+  file->mem_close();
+  file->data_close();
+}
+
+//----------------------------------------------------------------------
+
 void OutputData::write_field_data
 ( 
   const FieldData * field_data,
@@ -217,8 +808,6 @@ void OutputData::write_field_data
   io_field_data()->set_field_data((FieldData*)field_data);
   io_field_data()->set_field_index(index_field);
 
-  FieldDescr * field_descr = cello::field_descr();
-  
   for (size_t i=0; i<io_field_data()->data_count(); i++) {
 
     void * buffer;
@@ -234,18 +823,75 @@ void OutputData::write_field_data
 
     // Write ith FieldData data
 
-    file_->mem_create(nx,ny,nz,nx,ny,nz,0,0,0);
+    write_field_array_ (file_,name,type,buffer,nxd,nyd,nzd,nx,ny,nz);
+  }
+
+}
+
+//----------------------------------------------------------------------
+
+void OutputData::set_field_layout_
+(File * file, const std::string & name, int nxd, int nyd, int nzd,
+ bool aggregate) throw()
+{
+  std::map<std::string,int>::const_iterator it_level =
+    field_compress_level_.find(name);
+
+  const int level = (it_level != field_compress_level_.end()) ?
+    it_level->second : compress_level_;
+
+  file->set_compress(level, compress_shuffle_ && level > 0);
+
+  // chunk dimensions are ordered as in data_create()
+
+  const int cx = chunk_size_.size() > 0 ? chunk_size_[0] : 0;
+  const int cy = chunk_size_.size() > 1 ? chunk_size_[1] : 0;
+  const int cz = chunk_size_.size() > 2 ? chunk_size_[2] : 0;
+
+  // aggregated datasets have at most one Block per chunk, and are
+  // contiguous if neither compressed nor chunked
+
+  const bool is_chunked = (level > 0 || cx > 0 || cy > 0 || cz > 0);
+
+  if (aggregate && ! is_chunked) {
+    file->set_chunk(0);
+  } else if (aggregate) {
+    if (nzd > 1) {
+      file->set_chunk(1,cz,cy,cx);
+    } else if (nyd > 1) {
+      file->set_chunk(1,cy,cx);
+    } else {
+      file->set_chunk(1,cx);
+    }
+  } else {
     if (nzd > 1) {
-      file_->data_create(name.c_str(),type,nzd,nyd,nxd,1,nz,ny,nx,1);
+      file->set_chunk(cz,cy,cx);
     } else if (nyd > 1) {
-      file_->data_create(name.c_str(),type,nyd,nxd,  1,1,ny,nx, 1,1);
+      file->set_chunk(cy,cx);
     } else {
-      file_->data_create(name.c_str(),type,nxd,  1,  1,1,nx,  1,1,1);
+      file->set_chunk(cx);
     }
-    file_->data_write(buffer);
-    file_->data_close();
   }
+}
 
+//----------------------------------------------------------------------
+
+void OutputData::write_field_array_
+(File * file, const std::string & name, int type, const void * buffer,
+ int nxd, int nyd, int nzd, int nx, int ny, int nz) throw()
+{
+  set_field_layout_ (file,name,nxd,nyd,nzd);
+
+  file->mem_create(nx,ny,nz,nx,ny,nz,0,0,0);
+  if (nzd > 1) {
+    file->data_create(name.c_str(),type,nzd,nyd,nxd,1,nz,ny,nx,1);
+  } else if (nyd > 1) {
+    file->data_create(name.c_str(),type,nyd,nxd,  1,1,ny,nx, 1,1);
+  } else {
+    file->data_create(name.c_str(),type,nxd,  1,  1,1,nx,  1,1,1);
+  }
+  file->data_write((void *)buffer);
+  file->data_close();
 }
 
 //----------------------------------------------------------------------
@@ -264,65 +910,234 @@ void OutputData::write_particle_data
   io_particle_data()->set_particle_data  ( (ParticleData*)  particle_data);
   io_particle_data()->set_particle_index(it);
 
-  // loop through attributes 
-  // loop through blocks
-  // write particle data for [it][ib][ia]
-
   const int nb = particle.num_batches(it);
   const int na = particle.num_attributes(it);
 
+  const int np = particle.num_particles (it);
+
+  // offset of the Block's particles in concatenated datasets
+
+  int offset = 0;
+
   // For each particle attribute
   for (int ia=0; ia<na; ia++) {
 
-    int np = particle.num_particles (it);
-
     const std::string name = "particle_"
       +                particle.type_name(it) + "_"
       +                particle.attribute_name(it,ia);
     
     const int type = particle.attribute_type(it,ia);
 
-    // create the disk array
-    file_->data_create(name.c_str(),type,np,1,1,1,np,1,1,1);
+    // collect the non-empty batches of particles
+
+    std::vector<const void *> batch_array;
+    std::vector<int>          batch_count;
+
+    for (int ib=0; ib<nb; ib++) {
+      const int mb = particle.num_particles(it,ib);
+      if (mb == 0) continue;
+      batch_array.push_back((const void *) particle.attribute_array(it,ia,ib));
+      batch_count.push_back(mb);
+    }
+
+    const int offset_ia = write_particle_attribute_
+      (file_,name,type,np,batch_array,batch_count);
+
+    ASSERT3 ("OutputData::write_particle_data()",
+	     "Particle attribute %s offset %d differs from offset %d",
+	     name.c_str(),offset_ia,offset,
+	     (ia == 0) || (offset_ia == offset));
+
+    offset = offset_ia;
+  }
+
+  if (particle_concatenate_) {
+    write_particle_index_(file_,particle.type_name(it),offset,np);
+  }
+
+}
+
+//----------------------------------------------------------------------
+
+int OutputData::write_particle_attribute_
+(File * file, const std::string & name, int type, int np,
+ const std::vector<const void *> & batch_array,
+ const std::vector<int> & batch_count) throw()
+{
+  // particle datasets are compressed as a single chunk, or chunked
+  // by data_append()
+
+  file->set_compress(compress_level_, compress_shuffle_ && compress_level_ > 0);
+  file->set_chunk(0);
+
+  // create the disk array, or extend the file's concatenated array
+
+  int offset = 0;
+
+  if (particle_concatenate_) {
+    offset = file->data_append(name,type,np);
+  } else {
+    file->data_create(name.c_str(),type,np,1,1,1,np,1,1,1);
+  }
     
-    int i0 = 0;
+  // size of the disk array
+  const int mp = offset + np;
+
+  int i0 = 0;
 
-    // for each batch of particles
+  // for each batch of particles
     
-    for (int ib=0; ib<nb; ib++) {
+  for (size_t ib=0; ib<batch_array.size(); ib++) {
       
-      int mb = particle.num_particles(it,ib);
+    const int mb = batch_count[ib];
 
-      // create the memory space for the batch
-      file_->mem_create(mb,1,1,mb,1,1,0,0,0);
+    // create the memory space for the batch
+    file->mem_create(mb,1,1,mb,1,1,0,0,0);
       
-      const void * buffer = (const void *) particle.attribute_array(it,ia,ib);
-
-      // find the hyper_slab of the disk dataset
-      file_->data_slice
-	(np, 1, 1, 1,
-	 mb, 1, 1, 1,
-	 i0, 0, 0, 0);
+    // find the hyper_slab of the disk dataset
+    file->data_slice
+      (mp, 1, 1, 1,
+       mb, 1, 1, 1,
+       offset+i0, 0, 0, 0);
       
-      i0 += mb;
+    i0 += mb;
 
-      // write the batch to disk
-      file_->data_write(buffer);
+    // write the batch to disk
+    file->data_write((void *)batch_array[ib]);
       
-      file_->mem_close();
-    }
+    file->mem_close();
+  }
 
-    // check that the number of particles equals the number written
+  // check that the number of particles equals the number written
     
-    ASSERT2 ("OutputData::write_particle_data()",
-	     "Particle count mismatch %d particles %d written",
-	     np,i0,
-	     np == i0);
+  ASSERT2 ("OutputData::write_particle_attribute_()",
+	   "Particle count mismatch %d particles %d written",
+	   np,i0,
+	   np == i0);
 
-    // close the attribute dataset
-    file_->data_close();
-  }
+  // close the attribute dataset
+  file->data_close();
+
+  return offset;
+}
+
+//----------------------------------------------------------------------
 
+void OutputData::write_particle_index_
+(File * file, const std::string & type_name, int offset, int np) throw()
+{
+  // index the Block's particles in the concatenated datasets
+
+  if (field_aggregate_) {
+    aggregate_particle_offset_[type_name].push_back(offset);
+    aggregate_particle_count_ [type_name].push_back(np);
+  } else {
+    const std::string prefix = "particle_" + type_name;
+    file->group_write_meta(&offset,prefix + "_offset",type_int32);
+    file->group_write_meta(&np,    prefix + "_count", type_int32);
+  }
 }
 
 //======================================================================
+
+//----------------------------------------------------------------------
+
+namespace {
+  /// Update an FNV-1a hash with the given bytes
+  uint64_t hash_bytes (uint64_t hash, const char * bytes, int64_t n)
+  {
+    for (int64_t i=0; i<n; i++) {
+      hash = (hash ^ (unsigned char)(bytes[i])) * 1099511628211ULL;
+    }
+    return hash;
+  }
+}
+
+//----------------------------------------------------------------------
+
+uint64_t OutputData::hash_block_ (const Block * block) throw()
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  ItIndex * it_f = it_field_index_;
+  if (it_f) {
+    FieldData * field_data = (FieldData *) block->data()->field_data();
+    io_field_data()->set_field_data(field_data);
+    for (it_f->first(); ! it_f->done();  it_f->next()  ) {
+      io_field_data()->set_field_index(it_f->value());
+      void * buffer;
+      int type;
+      int nx,ny,nz;
+      io_field_data()->field_array(0, &buffer, NULL, &type, 
+				   NULL,NULL,NULL, &nx,&ny,&nz);
+      const int64_t bytes = (int64_t) cello::sizeof_type(type)*nx*ny*nz;
+      hash = hash_bytes (hash,(const char *)buffer,bytes);
+    }
+  }
+
+  // particle counts are included so that removed particles change
+  // the hash
+
+  ItIndex * it_p = it_particle_index_;
+  if (it_p) {
+    Particle particle = ((Block *)block)->data()->particle();
+    for (it_p->first(); ! it_p->done();  it_p->next()  ) {
+      const int it = it_p->value();
+      const int np = particle.num_particles(it);
+      hash = hash_bytes (hash,(const char *)&np,sizeof(np));
+      const int na = particle.num_attributes(it);
+      const int nb = particle.num_batches(it);
+      for (int ia=0; ia<na; ia++) {
+	const int bytes  = particle.attribute_bytes(it,ia);
+	const int stride = particle.stride(it,ia);
+	for (int ib=0; ib<nb; ib++) {
+	  const int mb = particle.num_particles(it,ib);
+	  const char * array = particle.attribute_array(it,ia,ib);
+	  for (int ip=0; ip<mb; ip++) {
+	    hash = hash_bytes (hash,array + ip*stride*bytes,bytes);
+	  }
+	}
+      }
+    }
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+
+std::string OutputData::file_unchanged_
+(const Block * block,
+ const std::string & name_dir,
+ const std::string & name_file) throw()
+{
+  const std::string name = block->name();
+  const std::string file = name_dir + "/" + name_file;
+  const uint64_t hash = hash_block_(block);
+
+  block_current_.insert(name);
+
+  // New Blocks, including those refined or coarsened since the last
+  // output, have no hash; a file is never referenced if this output
+  // overwrites it
+
+  const bool is_full = (count_ % full_interval_ == 0);
+
+  std::map<std::string,uint64_t>::iterator it_hash = block_hash_.find(name);
+
+  if (! is_full && it_hash != block_hash_.end() && it_hash->second == hash
+      && block_file_[name] != file) {
+
+    // path of the file relative to this output's directory
+
+    const std::string & file_old = block_file_[name];
+    const size_t pos = file_old.rfind("/");
+    return (file_old.substr(0,pos) == name_dir) ?
+      file_old.substr(pos+1) : "../" + file_old;
+  }
+
+  block_hash_[name] = hash;
+  block_file_[name] = file;
+
+  return "";
+}
@@ -21,7 +21,35 @@ class OutputData : public Output {
 public: // functions
 
   /// Empty constructor for Charm++ pup()
-  OutputData() throw() : text_block_count_(0) {}
+  OutputData() throw()
+    : text_block_count_(0),
+      particle_concatenate_(false),
+      field_aggregate_(false),
+      link_name_(""),
+      link_args_(),
+      block_names_(),
+      async_(false),
+      async_max_bytes_(0),
+      staged_(),
+      staged_bytes_(0),
+      file_staged_(0),
+      compress_level_(0),
+      compress_shuffle_(false),
+      chunk_size_(),
+      field_compress_level_(),
+      aggregate_fields_(),
+      aggregate_index_(),
+      aggregate_level_(),
+      aggregate_lower_(),
+      aggregate_upper_(),
+      aggregate_particle_offset_(),
+      aggregate_particle_count_(),
+      incremental_(false),
+      full_interval_(1),
+      block_hash_(),
+      block_file_(),
+      block_current_()
+  {}
 
   /// Create an uninitialized OutputData object
   OutputData(int index,
@@ -37,7 +65,33 @@ public: // functions
   /// Charm++ PUP::able migration constructor
   OutputData (CkMigrateMessage *m)
     : Output (m),
-      text_block_count_(0)
+      text_block_count_(0),
+      particle_concatenate_(false),
+      field_aggregate_(false),
+      link_name_(""),
+      link_args_(),
+      block_names_(),
+      async_(false),
+      async_max_bytes_(0),
+      staged_(),
+      staged_bytes_(0),
+      file_staged_(0),
+      compress_level_(0),
+      compress_shuffle_(false),
+      chunk_size_(),
+      field_compress_level_(),
+      aggregate_fields_(),
+      aggregate_index_(),
+      aggregate_level_(),
+      aggregate_lower_(),
+      aggregate_upper_(),
+      aggregate_particle_offset_(),
+      aggregate_particle_count_(),
+      incremental_(false),
+      full_interval_(1),
+      block_hash_(),
+      block_file_(),
+      block_current_()
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -75,11 +129,179 @@ public: // virtual functions
   ( const ParticleData * particle_data,
     int index_particle) throw();
 
+  /// Whether the root process writes a shared link file
+  virtual bool is_linked () const throw()
+  { return link_name_ != ""; }
+
+  /// Return local Block entries for the shared link file
+  virtual std::string link_entries () const throw();
+
+  /// Write the shared link file given all processes' entries
+  virtual void write_link (const std::string & entries) throw();
+
+  /// Write the next staged Block to the file closed by close()
+  virtual bool write_staged () throw();
+
+private: // types
+
+  /// Copy of one array written to the file: Block meta data, a
+  /// field, or all particles of one attribute
+  struct StagedArray {
+    std::string name;
+    int type;
+    int nxd,nyd,nzd;  // Array dimension
+    int nx,ny,nz;     // Array size
+    std::vector<char> values;
+  };
+
+  /// Copy of one particle type's attributes
+  struct StagedParticles {
+    std::string type_name;
+    int np;
+    std::vector<StagedArray> attributes;
+  };
+
+  /// Copy of all data written for a Block
+  struct StagedBlock {
+    std::string name;
+    std::vector<StagedArray> meta;
+    std::vector<StagedArray> fields;
+    std::vector<StagedParticles> particles;
+  };
+
+private: // functions
+
+  /// Number of bytes needed to stage the Block's output data
+  int64_t staged_bytes_block_ (const Block * block) throw();
+
+  /// Copy the Block's output data to the staging buffer
+  void stage_block_ (const Block * block) throw();
+
+  /// Append the Block's fields and index to the aggregated arrays,
+  /// and append its particles to the file
+  void aggregate_block_ (const Block * block) throw();
+
+  /// Write aggregated fields and Block index tables to the file
+  void write_aggregate_ (File * file) throw();
+
+  /// Write an [n1][n2] array of the aggregated Block index table
+  void write_table_
+  (File * file, const std::string & name, int type, int n1, int n2,
+   const void * buffer) throw();
+
+  /// Set the file's compression and chunking for the named field
+  void set_field_layout_ (File * file, const std::string & name, 
+			  int nxd, int nyd, int nzd,
+			  bool aggregate = false) throw();
+
+  /// Write a field array to the current group of the file
+  void write_field_array_
+  (File * file, const std::string & name, int type, const void * buffer,
+   int nxd, int nyd, int nzd, int nx, int ny, int nz) throw();
+
+  /// Write batches of one particle attribute, and return the offset
+  /// of the first particle in the dataset
+  int write_particle_attribute_
+  (File * file, const std::string & name, int type, int np,
+   const std::vector<const void *> & batch_array,
+   const std::vector<int> & batch_count) throw();
+
+  /// Write the offset and count of a Block's particles in
+  /// concatenated datasets
+  void write_particle_index_
+  (File * file, const std::string & type_name, int offset, int np) throw();
+
+  /// Return a hash of the Block's output field and particle data
+  uint64_t hash_block_ (const Block * block) throw();
+
+  /// Return the file holding the Block's data if it is unchanged
+  /// since it was last written, or "" if it must be written
+  std::string file_unchanged_ (const Block * block,
+			       const std::string & name_dir,
+			       const std::string & name_file) throw();
+
 protected:
 
   /// Count of number of Blocks sent from local process for text file
   /// output
   int text_block_count_;
+
+  /// Whether particle attributes are appended to one dataset per
+  /// attribute in the file, indexed by offset and count attributes in
+  /// each Block group, instead of written to datasets in Block groups
+  bool particle_concatenate_;
+
+  /// Whether each field is written as one [block][z][y][x] dataset
+  /// per file instead of to datasets in Block groups
+  bool field_aggregate_;
+
+  /// Name of the shared file linking to all Block groups, if any
+  std::string link_name_;
+
+  /// Format strings for the link file name, if any
+  std::vector<std::string> link_args_;
+
+  /// Names of the Blocks written to the local file in this output
+  std::vector<std::string> block_names_;
+
+  /// Whether Blocks are copied to a staging buffer and written after
+  /// close() while the simulation continues
+  bool async_;
+
+  /// Limit on staging memory; Blocks exceeding it are written directly
+  int64_t async_max_bytes_;
+
+  /// Blocks copied but not yet written (not checkpointed)
+  std::list<StagedBlock *> staged_;
+
+  /// Bytes in the staging buffer
+  int64_t staged_bytes_;
+
+  /// File staged Blocks are written to after close()
+  File * file_staged_;
+
+  /// HDF5 deflate level, 0 for uncompressed
+  int compress_level_;
+
+  /// Whether to shuffle bytes before compressing
+  bool compress_shuffle_;
+
+  /// Chunk size of field datasets along each axis, 0 for the array size
+  std::vector<int> chunk_size_;
+
+  /// Field dataset compression levels that differ from compress_level_
+  std::map<std::string,int> field_compress_level_;
+
+  /// Aggregated field arrays of the Blocks written in this output
+  /// (not checkpointed)
+  std::vector<StagedArray> aggregate_fields_;
+
+  /// Block index table: Index values, level, and extents
+  std::vector<int>    aggregate_index_;
+  std::vector<int>    aggregate_level_;
+  std::vector<double> aggregate_lower_;
+  std::vector<double> aggregate_upper_;
+
+  /// Block index table: offset and count of each Block's particles
+  /// in the concatenated datasets, by particle type name
+  std::map<std::string, std::vector<int> > aggregate_particle_offset_;
+  std::map<std::string, std::vector<int> > aggregate_particle_count_;
+
+  /// Whether only Blocks changed since the previous output are
+  /// written, with unchanged Blocks' data referenced in the block list
+  bool incremental_;
+
+  /// Number of outputs between outputs writing all Blocks
+  int full_interval_;
+
+  /// Hash of each local Block's data when last written
+  std::map<std::string,uint64_t> block_hash_;
+
+  /// "dir/file" each local Block's data was last written to
+  std::map<std::string,std::string> block_file_;
+
+  /// Names of the local Blocks in the current output
+  std::set<std::string> block_current_;
 };
 
 #endif /* IO_OUTPUT_DATA_HPP */
@@ -41,8 +41,10 @@ OutputImage::OutputImage(int index,
 			 bool ghost,
 			 double min_value, double max_value) throw ()
 : Output(index,factory),
-    image_data_(NULL),
-    image_mesh_(NULL),
+    image_data_(),
+    image_mesh_(),
+    ntx_(0),
+    nty_(0),
     color_particle_attribute_(color_particle_attribute),
     axis_(axis),
     min_value_(min_value),max_value_(max_value),
@@ -103,9 +105,6 @@ OutputImage::OutputImage(int index,
   
   // Override default Output::stride_write_: only root writes
   set_stride_write (process_count);
-  // Let all processes contribute data when its available
-  // (wait stride may be helpful for performance?)
-  stride_wait_ = 1;
 
   // Set default color map to be black and white
   map_r_.resize(2);
@@ -132,14 +131,8 @@ OutputImage::~OutputImage() throw ()
 {
   delete png_;
   png_ = NULL;
-  delete [] image_data_;
-  image_data_ = NULL;
-  delete [] image_mesh_;
-  image_mesh_ = NULL;
-#ifdef DEBUG_OUTPUT
-  CkPrintf ("%d TRACE_OUTPUT ~OutputImage %p %p\n",
-	    CkMyPe(),image_data_,image_mesh_); fflush(stdout);
-#endif  
+  for (size_t it=0; it<image_data_.size(); it++) delete [] image_data_[it];
+  for (size_t it=0; it<image_mesh_.size(); it++) delete [] image_mesh_[it];
 }
 
 //----------------------------------------------------------------------
@@ -160,27 +153,10 @@ void OutputImage::pup (PUP::er &p)
   p | nxi_;
   p | nyi_;
 
-  int has_data = (image_data_ != NULL);
-  p | has_data;
-  if (has_data) {
-    if (p.isUnpacking()) image_data_ = new double [nxi_*nyi_];
-    PUParray(p,image_data_,nxi_*nyi_);
-  } else {
-    image_data_ = NULL;
-  }
-
-  int has_mesh = (image_mesh_ != NULL);
-  p | has_mesh;
-  if (has_mesh) {
-    if (p.isUnpacking()) image_mesh_ = new double [nxi_*nyi_];
-    PUParray(p,image_mesh_,nxi_*nyi_);
-  } else {
-    image_mesh_ = NULL;
-  }
-#ifdef DEBUG_OUTPUT
-  CkPrintf ("%d TRACE_OUTPUT pup %p %p\n",
-	    CkMyPe(),image_data_,image_mesh_); fflush(stdout);
-#endif  
+  p | ntx_;
+  p | nty_;
+  pup_tiles_(p,image_data_);
+  pup_tiles_(p,image_mesh_);
   
   WARNING("OutputImage::pup","skipping png");
   // p | *png_;
@@ -199,6 +175,23 @@ void OutputImage::pup (PUP::er &p)
 
 //----------------------------------------------------------------------
 
+void OutputImage::pup_tiles_ (PUP::er &p, Tiles & tiles)
+{
+  int nt = tiles.size();
+  p | nt;
+  if (p.isUnpacking()) tiles.assign(nt,(double *)NULL);
+  for (int it=0; it<nt; it++) {
+    int has_tile = (tiles[it] != NULL);
+    p | has_tile;
+    if (has_tile) {
+      if (p.isUnpacking()) tiles[it] = new double [tile_size*tile_size];
+      PUParray(p,tiles[it],tile_size*tile_size);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
 void OutputImage::set_colormap
 (int n, double * map_r, double * map_g, double * map_b) throw()
 {
@@ -222,6 +215,11 @@ void OutputImage::init () throw()
 {
   TRACE_OUTPUT("OutputImage::init()");
   image_create_();
+
+  // wait for this process's blocks and each child in the compositing
+  // tree; set here since all processes call init() before any write
+
+  sync_write_.set_stop(1 + num_children());
 }
 
 //----------------------------------------------------------------------
@@ -493,24 +491,31 @@ void OutputImage::write_block ( const Block *  block ) throw()
     const int ia_color = (color_particle_attribute_ != "") ?
       particle.attribute_index (it, color_particle_attribute_) : -1;
 
-    // get particle attribute stride
-    const int ia_x = particle.attribute_position(it,0);
-    const int dp = particle.stride(it,ia_x);
+    // block-local integer positions u in [-1,1) are converted to
+    // absolute coordinates using the Block extents
+
+    const bool is_int = (particle.position_int_max(it) != 0);
+    const double xs = is_int ? 0.5*(bp3[IX]-bm3[IX]) : 1.0;
+    const double ys = is_int ? 0.5*(bp3[IY]-bm3[IY]) : 1.0;
+    const double xo = is_int ? bm3[IX] + xs : 0.0;
+    const double yo = is_int ? bm3[IY] + ys : 0.0;
 
     const int nb = particle.num_batches(it);
     const int da = (ia_color != -1) ? particle.stride(it,ia_color) : 0;
+    std::vector<double> position[3];
     for (int ib=0; ib<nb; ib++) {
 
       const int np = particle.num_particles(it,ib);
-      double position[3][np];
-      particle.position(it,ib, position[0], position[1], position[2]);
-      const double * xa = position[IX];
-      const double * ya = position[IY];
+      for (int axis=0; axis<3; axis++) position[axis].assign(np,0.0);
+      particle.position(it,ib, position[0].data(), position[1].data(),
+			position[2].data());
+      const double * xa = position[IX].data();
+      const double * ya = position[IY].data();
       double * pa = (double *) particle.attribute_array (it,ia_color,ib);
       for (int ip=0; ip<np; ip++) {
 
- 	double x = xa[ip*dp];
- 	double y = ya[ip*dp];
+ 	double x = xo + xs*xa[ip];
+ 	double y = yo + ys*ya[ip];
  	double value = (ia_color == -1) ? 1.0 : pa[ip*da];
 	double tx = nxi_*(x - xdm)/(xdp-xdm) - 0.5;
 	double ty = nyi_*(y - ydm)/(ydp-ydm) - 0.5;
@@ -562,15 +567,26 @@ void OutputImage::prepare_remote (int * n, char ** buffer) throw()
   TRACE("OutputImage::prepare_remote()");
   DEBUG("prepare_remote");
 
+  // Send only the tiles touched by this process's compositing
+  // subtree, each with its index and whether data and mesh are sent
+
+  const int nt = ntx_*nty_;
+  const int mt = tile_size*tile_size;
+
   int size = 0;
-  int nx = nxi_;
-  int ny = nyi_;
+  int count = 0;
 
   // Determine buffer size
 
-  size += 2*sizeof(int);        // nxi_, nyi_
-  size += nx*ny*sizeof(double); // image_data_
-  size += nx*ny*sizeof(double); // image_mesh_
+  size += 2*sizeof(int);        // count, tile_size
+  for (int it=0; it<nt; it++) {
+    if (! is_tile_empty_(it)) {
+      ++count;
+      size += 2*sizeof(int);    // it, flags
+      if (image_data_[it]) size += mt*sizeof(double);
+      if (image_mesh_[it]) size += mt*sizeof(double);
+    }
+  }
   (*n) = size;
 
   // Allocate buffer (deallocated in cleanup_remote())
@@ -584,12 +600,21 @@ void OutputImage::prepare_remote (int * n, char ** buffer) throw()
 
   p.c = (*buffer);
 
-  *p.i++ = nx;
-  *p.i++ = ny;
+  *p.i++ = count;
+  *p.i++ = tile_size;
 
-  for (int k=0; k<nx*ny; k++) *p.d++ = image_data_[k];
-  for (int k=0; k<nx*ny; k++) *p.d++ = image_mesh_[k];
-  
+  for (int it=0; it<nt; it++) {
+    if (! is_tile_empty_(it)) {
+      *p.i++ = it;
+      *p.i++ = (image_data_[it] ? 1 : 0) + (image_mesh_[it] ? 2 : 0);
+      if (image_data_[it]) {
+	for (int k=0; k<mt; k++) *p.d++ = image_data_[it][k];
+      }
+      if (image_mesh_[it]) {
+	for (int k=0; k<mt; k++) *p.d++ = image_mesh_[it][k];
+      }
+    }
+  }
 }
 
 //----------------------------------------------------------------------
@@ -607,28 +632,44 @@ void OutputImage::update_remote  ( int m, char * buffer) throw()
 
   p.c = buffer;
 
-  const int nx = *p.i++;
-  const int ny = *p.i++;
+  const int count = *p.i++;
 
-  const int n = nx*ny;
-  
-  if (op_reduce_ == reduce_min) {
-    for (int k=0; k<n; k++) image_data_[k] = std::min(image_data_[k],*p.d++);
-    for (int k=0; k<n; k++) image_mesh_[k] = std::min(image_mesh_[k],*p.d++);
-  } else if (op_reduce_ == reduce_max) {
-    for (int k=0; k<n; k++) image_data_[k] = std::max(image_data_[k],*p.d++);
-    for (int k=0; k<n; k++) image_mesh_[k] = std::max(image_mesh_[k],*p.d++);
-  } else if (op_reduce_ == reduce_sum) {
-    for (int k=0; k<n; k++) image_data_[k] += *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k] += *p.d++;
-  } else if (op_reduce_ == reduce_avg) {
-    for (int k=0; k<n; k++) image_data_[k] += *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k] += *p.d++;
-  } else if (op_reduce_ == reduce_set) {
-    for (int k=0; k<n; k++) image_data_[k]  = *p.d++;
-    for (int k=0; k<n; k++) image_mesh_[k]  = *p.d++;
-  }
+  ASSERT2 ("OutputImage::update_remote()",
+	   "Received tile size %d differs from tile size %d",
+	   *p.i,int(tile_size),
+	   *p.i == tile_size);
+  p.i++;
+
+  const int mt = tile_size*tile_size;
+
+  Tiles * images[2] = { &image_data_, &image_mesh_ };
+
+  for (int i=0; i<count; i++) {
+
+    const int it    = *p.i++;
+    const int flags = *p.i++;
 
+    for (int k=0; k<2; k++) {
+
+      if (! (flags & (1 << k))) continue;
+
+      double * & tile = (*images[k])[it];
+
+      if (tile == NULL) tile = tile_create_();
+
+      if (op_reduce_ == reduce_min) {
+	for (int j=0; j<mt; j++) tile[j] = std::min(tile[j],*p.d++);
+      } else if (op_reduce_ == reduce_max) {
+	for (int j=0; j<mt; j++) tile[j] = std::max(tile[j],*p.d++);
+      } else if (op_reduce_ == reduce_sum) {
+	for (int j=0; j<mt; j++) tile[j] += *p.d++;
+      } else if (op_reduce_ == reduce_avg) {
+	for (int j=0; j<mt; j++) tile[j] += *p.d++;
+      } else if (op_reduce_ == reduce_set) {
+	for (int j=0; j<mt; j++) tile[j]  = *p.d++;
+      }
+    }
+  }
 }
 
 //----------------------------------------------------------------------
@@ -703,73 +744,95 @@ void OutputImage::image_create_ () throw()
 {
   ASSERT("OutputImage::image_create_",
 	 "image_ already created",
-	 image_data_ == NULL || image_mesh_ == NULL);
+	 image_data_.empty() || image_mesh_.empty());
 
-  image_data_  = new double [nxi_*nyi_];
-  image_mesh_  = new double [nxi_*nyi_];
-  TRACE2("new image_data_ = %p image_mesh_ = %p",image_data_,image_mesh_);
-#ifdef DEBUG_OUTPUT
-  CkPrintf ("%d TRACE_OUTPUT image_create_ %p %p\n",
-	    CkMyPe(),image_data_,image_mesh_); fflush(stdout);
-#endif  
+  // tiles are allocated when first touched
+
+  ntx_ = (nxi_ + tile_size - 1) / tile_size;
+  nty_ = (nyi_ + tile_size - 1) / tile_size;
+
+  image_data_.assign(ntx_*nty_,(double *)NULL);
+  image_mesh_.assign(ntx_*nty_,(double *)NULL);
+}
+
+//----------------------------------------------------------------------
 
+double OutputImage::value0_ () const throw()
+{
   const double min = std::numeric_limits<double>::max();
   const double max = -min;
 
-  double value0;
-
   switch (op_reduce_) {
   case reduce_min: 
-    value0 = min;
-    break;
+    return min;
   case reduce_max: 
-    value0 = max;
-    break;
+    return max;
   case reduce_avg: 
   case reduce_sum: 
   case reduce_set:
   default:         
-    value0 = 0; 
-    break;
+    return 0; 
   }
+}
 
-  for (int i=0; i<nxi_*nyi_; i++) image_data_[i] = value0;
-  for (int i=0; i<nxi_*nyi_; i++) image_mesh_[i] = value0;
+//----------------------------------------------------------------------
 
+double * OutputImage::tile_create_ () const throw()
+{
+  const int mt = tile_size*tile_size;
+  double * tile = new double [mt];
+  const double value0 = value0_();
+  for (int k=0; k<mt; k++) tile[k] = value0;
+  return tile;
 }
 
 //----------------------------------------------------------------------
 
-void OutputImage::image_write_ () throw()
+double & OutputImage::pixel_ (Tiles & tiles, int ix, int iy) throw()
 {
-  // simplified variable names
+  double * & tile = tiles[ix/tile_size + ntx_*(iy/tile_size)];
+  if (tile == NULL) tile = tile_create_();
+  return tile[ix%tile_size + tile_size*(iy%tile_size)];
+}
 
-  int mx = nxi_;
-  int my = nyi_;
-  int m  = mx*my;
+//----------------------------------------------------------------------
 
-  double min,max;
+double OutputImage::pixel_value_
+(const Tiles & tiles, int ix, int iy) const throw()
+{
+  const double * tile = tiles[ix/tile_size + ntx_*(iy/tile_size)];
+  return tile ? tile[ix%tile_size + tile_size*(iy%tile_size)] : value0_();
+}
 
+//----------------------------------------------------------------------
+
+void OutputImage::image_write_ () throw()
+{
+  double min,max;
 
   min = std::numeric_limits<double>::max();
   max = -min;
 
-  // Compute min and max
+  // Compute min and max, using one pixel for all untouched tiles
 
-  if (image_log_) {
-    for (int i=0; i<m; i++) {
-      min = MIN(min,log(data_(i)));
-      max = MAX(max,log(data_(i)));
-    }
-  } else if (image_abs_) {
-    for (int i=0; i<m; i++) {
-      min = MIN(min,fabs(data_(i)));
-      max = MAX(max,fabs(data_(i)));
-    }
-  } else { 
-    for (int i=0; i<m; i++) {
-      min = MIN(min,data_(i));
-      max = MAX(max,data_(i));
+  bool is_empty_done = false;
+
+  for (int ty=0; ty<nty_; ty++) {
+    for (int tx=0; tx<ntx_; tx++) {
+      const int ixm = tx*tile_size;
+      const int iym = ty*tile_size;
+      if (is_tile_empty_(tx + ntx_*ty)) {
+	if (! is_empty_done) min_max_(data_(ixm,iym),&min,&max);
+	is_empty_done = true;
+	continue;
+      }
+      const int ixp = std::min(ixm + int(tile_size), nxi_);
+      const int iyp = std::min(iym + int(tile_size), nyi_);
+      for (int iy=iym; iy<iyp; iy++) {
+	for (int ix=ixm; ix<ixp; ix++) {
+	  min_max_(data_(ix,iy),&min,&max);
+	}
+      }
     }
   }
 
@@ -778,71 +841,95 @@ void OutputImage::image_write_ () throw()
   min = MIN(min,min_value_);
   max = MAX(max,max_value_);
 
-  size_t n = map_r_.size();
-
-  // loop over pixels (ix,iy)
-
-  for (int ix = 0; ix<mx; ix++) {
-
-    for (int iy = 0; iy<my; iy++) {
-
-      int i = ix + mx*iy;
-
-      double value = data_(i);
-
-      if (image_abs_) value = fabs(value);
-      if (image_log_) value = log(value);
+  // plot pixels tile by tile, computing the color of untouched tiles
+  // once
 
+  for (int ty=0; ty<nty_; ty++) {
+    for (int tx=0; tx<ntx_; tx++) {
+      const int ixm = tx*tile_size;
+      const int iym = ty*tile_size;
+      const int ixp = std::min(ixm + int(tile_size), nxi_);
+      const int iyp = std::min(iym + int(tile_size), nyi_);
+      const bool is_empty = is_tile_empty_(tx + ntx_*ty);
       double r=0.0,g=0.0,b=0.0;
+      if (is_empty) color_(data_(ixm,iym),min,max,&r,&g,&b);
+      for (int iy=iym; iy<iyp; iy++) {
+	for (int ix=ixm; ix<ixp; ix++) {
+	  if (! is_empty) color_(data_(ix,iy),min,max,&r,&g,&b);
+	  png_->plot (ix+1, iy+1, r,g,b);
+	}
+      }
+    }
+  }
+}
 
-      if (value < min) value = min;
-      if (value > max) value = max;
+//----------------------------------------------------------------------
 
+void OutputImage::min_max_
+(double value, double * min, double * max) const throw()
+{
+  if (image_log_) {
+    value = log(value);
+  } else if (image_abs_) {
+    value = fabs(value);
+  }
+  *min = MIN(*min,value);
+  *max = MAX(*max,value);
+}
 
-      if (min <= value && value <= max) {
+//----------------------------------------------------------------------
 
-	// map v to lower colormap index
-	size_t k =  (n - 1)*(value - min) / (max-min);
+void OutputImage::color_
+(double value, double min, double max,
+ double * r, double * g, double * b) const throw()
+{
+  size_t n = map_r_.size();
 
-	// prevent k == map_.size()-1, which happens if value == max
+  if (image_abs_) value = fabs(value);
+  if (image_log_) value = log(value);
 
-	if (k > n - 2) k = n-2;
+  if (value < min) value = min;
+  if (value > max) value = max;
 
-	// linear interpolate colormap values
-	double lo = min +  k   *(max-min)/(n-1);
-	double hi = min + (k+1)*(max-min)/(n-1);
+  if (min <= value && value <= max) {
 
-	double ratio = (value - lo) / (hi-lo);
+    // map v to lower colormap index
+    size_t k =  (n - 1)*(value - min) / (max-min);
 
-	r = (1-ratio)*map_r_[k] + ratio*map_r_[k+1];
-	g = (1-ratio)*map_g_[k] + ratio*map_g_[k+1];
-	b = (1-ratio)*map_b_[k] + ratio*map_b_[k+1];
+    // prevent k == map_.size()-1, which happens if value == max
 
-	png_->plot      (ix+1, iy+1, r,g,b);
+    if (k > n - 2) k = n-2;
 
-      } else {
-	
-	// red if out of bounds
-	png_->plot(ix+1, iy+1, 1.0, 0.0, 0.0);
+    // linear interpolate colormap values
+    double lo = min +  k   *(max-min)/(n-1);
+    double hi = min + (k+1)*(max-min)/(n-1);
 
-      }
+    double ratio = (value - lo) / (hi-lo);
 
-      // Plot pixel
-    }
-  }      
+    *r = (1-ratio)*map_r_[k] + ratio*map_r_[k+1];
+    *g = (1-ratio)*map_g_[k] + ratio*map_g_[k+1];
+    *b = (1-ratio)*map_b_[k] + ratio*map_b_[k+1];
 
+  } else {
+	
+    // red if out of bounds
+    *r = 1.0;
+    *g = 0.0;
+    *b = 0.0;
+  }
 }
 
 //----------------------------------------------------------------------
 
-double OutputImage::data_(int index) const
+double OutputImage::data_(int ix, int iy) const
 {
   if (type_is_mesh_() && type_is_data_())
-    return (image_data_[index] + 0.2*image_mesh_[index])/1.2;
+    return (pixel_value_(image_data_,ix,iy) +
+	    0.2*pixel_value_(image_mesh_,ix,iy))/1.2;
   else if (type_is_data_()) 
-    return image_data_[index];
+    return pixel_value_(image_data_,ix,iy);
   else  if (type_is_mesh_()) 
-    return image_mesh_[index];
+    return pixel_value_(image_mesh_,ix,iy);
   else {
     ERROR ("OutputImage::data_()",
 	   "image_type is neither mesh nor data");
@@ -856,25 +943,19 @@ void OutputImage::image_close_ () throw()
 {
   ASSERT("OutputImage::image_create_",
 	 "image_ already created",
-	 image_data_ != NULL || image_mesh_ != NULL);
+	 ! image_data_.empty() || ! image_mesh_.empty());
 
-  TRACE1("delete image_data_ = %p",image_data_);
-  delete [] image_data_;
-  image_data_ = 0;
+  for (size_t it=0; it<image_data_.size(); it++) delete [] image_data_[it];
+  for (size_t it=0; it<image_mesh_.size(); it++) delete [] image_mesh_[it];
 
-  TRACE1("delete image_mesh_ = %p",image_mesh_)
-  delete [] image_mesh_;
-  image_mesh_ = 0;
-#ifdef DEBUG_OUTPUT
-  CkPrintf ("%d TRACE_OUTPUT image_close_ %p %p\n",
-	    CkMyPe(),image_data_,image_mesh_); fflush(stdout);
-#endif  
+  image_data_.clear();
+  image_mesh_.clear();
 }
 
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_point_ 
-(double * data, int ix, int iy, double value, double alpha) throw()
+(Tiles & data, int ix, int iy, double value, double alpha) throw()
 {
   if ( ! (0 <= ix && ix < nxi_)) return;
   if ( ! (0 <= iy && iy < nyi_)) return;
@@ -884,34 +965,34 @@ void OutputImage::reduce_point_
 	     "Alpha %g is not between 0.0 and 1.0",
 	      alpha);
   }
-  const int i = ix + nxi_*iy;
+  double & pixel = pixel_(data,ix,iy);
 
   double value_new = 0.0;
   
   switch (op_reduce_) {
   case reduce_min:
-    value_new = alpha*value + (1-alpha)*(data[i]);
-    data[i] = std::min(data[i],value_new); 
+    value_new = alpha*value + (1-alpha)*(pixel);
+    pixel = std::min(pixel,value_new); 
     break;
   case reduce_max:
-    value_new = alpha*value + (1-alpha)*(data[i]);
-    data[i] = std::max(data[i],value_new); 
+    value_new = alpha*value + (1-alpha)*(pixel);
+    pixel = std::max(pixel,value_new); 
     break;
   case reduce_avg:
   case reduce_sum:
     value_new = alpha*value;
-    data[i] += value_new;
+    pixel += value_new;
     break;
   case reduce_set:
-    value_new = alpha*value + (1-alpha)*(data[i]);
-    data[i] = value_new;
+    value_new = alpha*value + (1-alpha)*(pixel);
+    pixel = value_new;
   }
 }
 
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_line_
-(double * data, 
+(Tiles & data, 
  int ix0, int ix1, 
  int iy0, int iy1, 
  double value, double alpha)
@@ -951,7 +1032,7 @@ void OutputImage::reduce_line_
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_line_x_
-(double * data, 
+(Tiles & data, 
  int ixm, int ixp,
  int iy,
  double value, double alpha)
@@ -967,7 +1048,7 @@ void OutputImage::reduce_line_x_
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_line_y_
-(double * data,
+(Tiles & data,
  int ix,
  int iym, int iyp,
  double value, double alpha)
@@ -982,7 +1063,7 @@ void OutputImage::reduce_line_y_
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_box_
-(double * data,
+(Tiles & data,
  int ixm, int ixp,
  int iym, int iyp, 
  double value, reduce_type reduce, double alpha)
@@ -1000,7 +1081,7 @@ void OutputImage::reduce_box_
 //----------------------------------------------------------------------
 
 void OutputImage::reduce_box_filled_
-(double * data, 
+(Tiles & data, 
  int ixm, int ixp,
  int iym, int iyp, 
  double value, double alpha)
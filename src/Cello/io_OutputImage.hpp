@@ -62,8 +62,10 @@ public: // functions
   OutputImage (CkMigrateMessage *m)
     : Output (m),
       map_r_(),map_g_(),map_b_(),
-      image_data_(NULL),
-      image_mesh_(NULL),
+      image_data_(),
+      image_mesh_(),
+      ntx_(0),
+      nty_(0),
       op_reduce_(reduce_unknown),
       mesh_color_type_(mesh_color_unknown),
       color_particle_attribute_(""),
@@ -132,6 +134,18 @@ public: // virtual functions
   /// Free local array if allocated; NOP if not
   virtual void cleanup_remote (int * n, char ** buffer) throw();
 
+  /// Images are composited along a binomial tree of processes
+  virtual bool is_tree_reduce () const throw()
+  { return true; }
+
+private: // types
+
+  /// Image stored as square tiles of tile_size pixels per side, each
+  /// NULL until a pixel in it is touched
+  typedef std::vector<double *> Tiles;
+
+  enum { tile_size = 64 };
+
 private: // functions
 
   /// value associated with the given mesh level
@@ -162,20 +176,47 @@ private: // functions
 
    /// Generate a PNG image of array data
   void reduce_point_
-  ( double * data,  int ix, int iy, double value, double alpha=1.0) throw();
+  ( Tiles & data,  int ix, int iy, double value, double alpha=1.0) throw();
 
-  void reduce_line_(double * data, int ixm, int ixp, int iym, int iyp, 
+  void reduce_line_(Tiles & data, int ixm, int ixp, int iym, int iyp, 
 		    double value, double alpha=1.0);
-  void reduce_line_x_(double * data, int ixm, int ixp, int iy, 
+  void reduce_line_x_(Tiles & data, int ixm, int ixp, int iy, 
 		      double value, double alpha=1.0);
-  void reduce_line_y_(double * data, int ix, int iym, int iyp, 
+  void reduce_line_y_(Tiles & data, int ix, int iym, int iyp, 
 		      double value, double alpha=1.0);
-  void reduce_box_(double * data, int ixm, int ixp, int iym, int iyp, 
+  void reduce_box_(Tiles & data, int ixm, int ixp, int iym, int iyp, 
 		   double value, reduce_type reduce, double alpha=1.0);
-  void reduce_box_filled_(double * data, int ixm, int ixp, int iym, int iyp, 
+  void reduce_box_filled_(Tiles & data, int ixm, int ixp, int iym, int iyp, 
 		    double value, double alpha=1.0);
 
-  double data_(int i) const ;
+  double data_(int ix, int iy) const ;
+
+  /// Return the image pixel, allocating its tile if needed
+  double & pixel_(Tiles & tiles, int ix, int iy) throw();
+
+  /// Return the image pixel, or the initial value if its tile is
+  /// not allocated
+  double pixel_value_(const Tiles & tiles, int ix, int iy) const throw();
+
+  /// Return whether neither the data nor mesh tile is allocated
+  bool is_tile_empty_(int it) const throw()
+  { return image_data_[it] == NULL && image_mesh_[it] == NULL; }
+
+  /// Allocate a tile with pixels set to the initial value
+  double * tile_create_() const throw();
+
+  /// Initial pixel value for the reduction operation
+  double value0_() const throw();
+
+  /// Pack / unpack allocated tiles
+  void pup_tiles_(PUP::er &p, Tiles & tiles);
+
+  /// Update min and max with the pixel value, using log or abs if set
+  void min_max_(double value, double * min, double * max) const throw();
+
+  /// Map the pixel value to a color given the colormap range
+  void color_(double value, double min, double max,
+	      double * r, double * g, double * b) const throw();
 
 private: // attributes
 
@@ -185,10 +226,13 @@ private: // attributes
   std::vector<double> map_b_;
 
   /// Current image for data
-  double * image_data_;
+  Tiles image_data_;
 
   /// Current image for mesh
-  double * image_mesh_;
+  Tiles image_mesh_;
+
+  /// Number of tiles along each axis of the current image
+  int ntx_, nty_;
 
   /// Reduction operation
   reduce_type op_reduce_;
@@ -239,7 +283,6 @@ private: // attributes
   /// Lower and upper bounds on image (can be used for slices)
   double image_lower_[3];
   double image_upper_[3];
-  
 };
 
 #endif /* IO_OUTPUT_IMAGE_HPP */
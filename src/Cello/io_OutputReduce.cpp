@@ -0,0 +1,473 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     io_OutputReduce.cpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2026-10-18
+/// @brief    Implementation of writing in-situ reductions of fields
+
+#include "cello.hpp"
+#include "io.hpp"
+
+//----------------------------------------------------------------------
+
+OutputReduce::OutputReduce
+(
+ int index,
+ const Factory * factory,
+ Config * config
+ ) throw ()
+  : Output(index,factory),
+    reduce_type_(reduce_output_unknown),
+    axis_(axis_z),
+    nx_(0), ny_(0),
+    position_(0.0),
+    radius_(0.0),
+    bins_(config->output_reduce_bins[index]),
+    range_min_(config->output_reduce_range[index][0]),
+    range_max_(config->output_reduce_range[index][1]),
+    log_(config->output_reduce_log[index]),
+    values_()
+{
+  // partial reductions are summed along the process tree to the
+  // root process, which writes the file
+
+  set_stride_write (CkNumPes());
+
+  const std::string type = config->output_reduce_type[index];
+
+  if      (type == "projection") reduce_type_ = reduce_output_projection;
+  else if (type == "slice")      reduce_type_ = reduce_output_slice;
+  else if (type == "profile")    reduce_type_ = reduce_output_profile;
+  else if (type == "histogram")  reduce_type_ = reduce_output_histogram;
+  else {
+    ERROR1 ("OutputReduce::OutputReduce()",
+	    "Unrecognized reduce type %s",
+	    type.c_str());
+  }
+
+  axis_ = config->output_axis[index][0] - 'x';
+
+  const int rank = config->mesh_root_rank;
+  const double * dm3 = config->domain_lower;
+  const double * dp3 = config->domain_upper;
+
+  if (reduce_type_ == reduce_output_projection ||
+      reduce_type_ == reduce_output_slice) {
+
+    ASSERT1 ("OutputReduce::OutputReduce()",
+	     "Output %d: projections and slices require rank >= 2",
+	     index, rank >= 2);
+
+    ASSERT1 ("OutputReduce::OutputReduce()",
+	     "Output %d: axis must be z for 2D projections and slices",
+	     index, rank >= 3 || axis_ == axis_z);
+
+    // default to one pixel per root-level cell
+
+    const int IX = (axis_+1) % 3;
+    const int IY = (axis_+2) % 3;
+
+    nx_ = config->output_reduce_size[index][0];
+    ny_ = config->output_reduce_size[index][1];
+    if (nx_ == 0) nx_ = config->mesh_root_size[IX];
+    if (ny_ == 0) ny_ = config->mesh_root_size[IY];
+  }
+
+  position_ = config->output_reduce_position[index];
+  if (position_ == std::numeric_limits<double>::max()) {
+    position_ = 0.5*(dm3[axis_] + dp3[axis_]);
+  }
+
+  radius_ = config->output_reduce_radius[index];
+  for (int axis=0; axis<3; axis++) {
+    center_[axis] = config->output_reduce_center[index][axis];
+    if (center_[axis] == std::numeric_limits<double>::max()) {
+      center_[axis] = 0.5*(dm3[axis] + dp3[axis]);
+    }
+  }
+
+  // default radius is half the smallest domain width
+
+  if (radius_ == 0.0) {
+    radius_ = std::numeric_limits<double>::max();
+    for (int axis=0; axis<rank; axis++) {
+      radius_ = std::min(radius_,0.5*(dp3[axis]-dm3[axis]));
+    }
+  }
+
+  ASSERT2 ("OutputReduce::OutputReduce()",
+	   "Output %d: profile radius %g must be positive",
+	   index, radius_,
+	   reduce_type_ != reduce_output_profile || radius_ > 0.0);
+
+  if (reduce_type_ == reduce_output_histogram) {
+
+    ASSERT3 ("OutputReduce::OutputReduce()",
+	     "Output %d: histogram range [%g,%g] must be set with min < max",
+	     index, range_min_,range_max_,
+	     range_min_ < range_max_);
+
+    ASSERT2 ("OutputReduce::OutputReduce()",
+	     "Output %d: logarithmic histogram range minimum %g must be > 0",
+	     index, range_min_,
+	     ! log_ || range_min_ > 0.0);
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::pup (PUP::er &p)
+{
+  TRACEPUP;
+  // NOTE: change this function whenever attributes change
+
+  Output::pup(p);
+
+  p | reduce_type_;
+  p | axis_;
+  p | nx_;
+  p | ny_;
+  p | position_;
+  PUParray(p,center_,3);
+  p | radius_;
+  p | bins_;
+  p | range_min_;
+  p | range_max_;
+  p | log_;
+  // values_ is only used between init() and close()
+}
+
+//======================================================================
+
+void OutputReduce::init () throw()
+{
+  const int num_fields = it_field_index_ ? it_field_index_->size() : 0;
+  const int n = num_values_();
+
+  values_.assign
+    (num_fields*n + ((reduce_type_ == reduce_output_profile) ? n : 0), 0.0);
+
+  // wait for this process's blocks and each child in the process
+  // tree; set here since all processes call init() before any write
+
+  sync_write_.set_stop(1 + num_children());
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::close () throw()
+{
+  if (is_writer()) {
+
+    std::string file_name = expand_name_ (&file_name_,&file_args_);
+
+    std::string dir_name = directory();
+
+    Monitor::instance()->print
+      ("Output","writing reduce file %s",
+       (dir_name + "/" + file_name).c_str());
+
+    FileHdf5 file (dir_name,file_name);
+
+    file.file_create();
+
+    Simulation * simulation = cello::simulation();
+    int    cycle = simulation->cycle();
+    double time  = simulation->time();
+    file.file_write_meta(&cycle,"cycle",type_int);
+    file.file_write_meta(&time, "time", type_double);
+
+    const std::string prefix =
+      (reduce_type_ == reduce_output_projection) ? "projection_" :
+      (reduce_type_ == reduce_output_slice)      ? "slice_" :
+      (reduce_type_ == reduce_output_profile)    ? "profile_" : "histogram_";
+
+    const int n = num_values_();
+    const bool is_image = (reduce_type_ == reduce_output_projection ||
+			   reduce_type_ == reduce_output_slice);
+    const int n1 = is_image ? ny_ : n;
+    const int n2 = is_image ? nx_ : 1;
+
+    // profile sums of value * volume become volume averages
+
+    const double * volume =
+      (reduce_type_ == reduce_output_profile) ?
+      &values_[values_.size()-n] : NULL;
+
+    FieldDescr * field_descr = cello::field_descr();
+
+    int index = 0;
+    for (it_field_index_->first();
+	 ! it_field_index_->done();
+	 it_field_index_->next(), index++) {
+
+      double * values = &values_[index*n];
+
+      if (volume) {
+	for (int i=0; i<n; i++) {
+	  if (volume[i] > 0.0) values[i] /= volume[i];
+	}
+      }
+
+      const std::string name =
+	prefix + field_descr->field_name(it_field_index_->value());
+
+      write_dataset_ (&file,name,values,n1,n2);
+    }
+
+    if (volume) {
+      write_dataset_ (&file,"profile_volume",volume,n,1);
+    }
+
+    if (! is_image) {
+      const double x0 = (reduce_type_ == reduce_output_profile) ? 0.0 :
+	(log_ ? log10(range_min_) : range_min_);
+      const double x1 = (reduce_type_ == reduce_output_profile) ? radius_ :
+	(log_ ? log10(range_max_) : range_max_);
+      std::vector<double> edges (n+1);
+      for (int i=0; i<=n; i++) edges[i] = x0 + i*(x1-x0)/n;
+      write_dataset_ (&file,"bin_edges",&edges[0],n+1,1);
+    }
+
+    file.file_close();
+  }
+
+  values_.clear();
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::write_block ( const Block * block ) throw()
+{
+  // reduce leaf Blocks only, so each point in the domain is counted once
+
+  if (! block->is_leaf() || values_.size() == 0) return;
+
+  Field field = ((Data *)block->data())->field();
+
+  const int rank = cello::rank();
+
+  int nb3[3] = {1,1,1};
+  field.size(&nb3[0],&nb3[1],&nb3[2]);
+
+  double bm3[3],bp3[3];
+  block->lower(bm3,bm3+1,bm3+2);
+  block->upper(bp3,bp3+1,bp3+2);
+
+  // cell widths, with unit width along axes beyond the rank
+
+  double h3[3];
+  for (int axis=0; axis<3; axis++) {
+    h3[axis] = (axis < rank) ? (bp3[axis]-bm3[axis])/nb3[axis] : 1.0;
+  }
+  const double volume = h3[0]*h3[1]*h3[2];
+
+  const int IX = (axis_+1) % 3;
+  const int IY = (axis_+2) % 3;
+  const int IZ = axis_;
+
+  // skip Blocks not intersecting the slice
+
+  if (reduce_type_ == reduce_output_slice && rank >= 3 &&
+      (position_ < bm3[IZ] || bp3[IZ] <= position_)) return;
+
+  const int n = num_values_();
+  double * volume_bins =
+    (reduce_type_ == reduce_output_profile) ? &values_[values_.size()-n] : NULL;
+
+  int index = 0;
+  for (it_field_index_->first();
+       ! it_field_index_->done();
+       it_field_index_->next(), index++) {
+
+    const int index_field = it_field_index_->value();
+
+    int ng3[3];
+    field.ghost_depth(index_field,&ng3[0],&ng3[1],&ng3[2]);
+
+    const int mx = nb3[0] + 2*ng3[0];
+    const int my = nb3[1] + 2*ng3[1];
+
+    const char * field_values = field.values(index_field);
+    const float  * field_float  = (const float *)  field_values;
+    const double * field_double = (const double *) field_values;
+
+    const int precision = field.precision(index_field);
+
+    ASSERT1 ("OutputReduce::write_block()",
+	     "Field %s must be single or double precision",
+	     field.field_name(index_field).c_str(),
+	     precision == precision_single || precision == precision_double);
+
+    double * values = &values_[index*n];
+
+    for (int iz=0; iz<nb3[2]; iz++) {
+      for (int iy=0; iy<nb3[1]; iy++) {
+	for (int ix=0; ix<nb3[0]; ix++) {
+
+	  const int i = (ix+ng3[0]) + mx*((iy+ng3[1]) + my*(iz+ng3[2]));
+
+	  const double value = (precision == precision_single) ?
+	    field_float[i] : field_double[i];
+
+	  const int i3[3] = {ix,iy,iz};
+	  double xm3[3];
+	  for (int axis=0; axis<3; axis++) {
+	    xm3[axis] = (axis < rank) ? bm3[axis] + i3[axis]*h3[axis] : 0.0;
+	  }
+
+	  if (reduce_type_ == reduce_output_projection) {
+
+	    // column integral along axis_
+
+	    const double depth = (rank >= 3) ? h3[IZ] : 1.0;
+	    deposit_ (values,
+		      xm3[IX],xm3[IX]+h3[IX],xm3[IY],xm3[IY]+h3[IY],
+		      value*depth);
+
+	  } else if (reduce_type_ == reduce_output_slice) {
+
+	    if (rank < 3 ||
+		(xm3[IZ] <= position_ && position_ < xm3[IZ]+h3[IZ])) {
+	      deposit_ (values,
+			xm3[IX],xm3[IX]+h3[IX],xm3[IY],xm3[IY]+h3[IY],
+			value);
+	    }
+
+	  } else if (reduce_type_ == reduce_output_profile) {
+
+	    double r2 = 0.0;
+	    for (int axis=0; axis<rank; axis++) {
+	      const double d = xm3[axis] + 0.5*h3[axis] - center_[axis];
+	      r2 += d*d;
+	    }
+	    const int ib = int(sqrt(r2) / radius_ * bins_);
+	    if (ib < bins_) {
+	      values[ib] += value*volume;
+	      if (index == 0) volume_bins[ib] += volume;
+	    }
+
+	  } else if (reduce_type_ == reduce_output_histogram) {
+
+	    if (log_ && value <= 0.0) continue;
+
+	    const double x  = log_ ? log10(value)      : value;
+	    const double x0 = log_ ? log10(range_min_) : range_min_;
+	    const double x1 = log_ ? log10(range_max_) : range_max_;
+	    if (x0 <= x && x < x1) {
+	      const int ib = std::min(int((x-x0)/(x1-x0)*bins_),bins_-1);
+	      values[ib] += volume;
+	    }
+	  }
+	}
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::prepare_remote (int * n, char ** buffer) throw()
+{
+  // Send the subtree's partial reductions: count and number of
+  // values per field, followed by the values
+
+  const int count = values_.size();
+
+  (*n) = 2*sizeof(int) + count*sizeof(double);
+
+  // Allocate buffer (deallocated in cleanup_remote())
+  (*buffer) = new char [ (*n) ];
+
+  union {
+    char   * c;
+    double * d;
+    int    * i;
+  } p ;
+
+  p.c = (*buffer);
+
+  *p.i++ = count;
+  *p.i++ = num_values_();
+  for (int i=0; i<count; i++) *p.d++ = values_[i];
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::update_remote  ( int n, char * buffer) throw()
+{
+  union {
+    char   * c;
+    double * d;
+    int    * i;
+  } p ;
+
+  p.c = buffer;
+
+  const int count = *p.i++;
+  const int n_values = *p.i++;
+
+  ASSERT4 ("OutputReduce::update_remote()",
+	   "Received %d values with %d per field but expected %d with %d",
+	   count, n_values, int(values_.size()), num_values_(),
+	   count == int(values_.size()) && n_values == num_values_());
+
+  for (int i=0; i<count; i++) values_[i] += *p.d++;
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::cleanup_remote  (int * n, char ** buffer) throw()
+{
+  delete [] (*buffer);
+  (*buffer) = NULL;
+}
+
+//======================================================================
+
+void OutputReduce::deposit_
+(double * image,
+ double xm, double xp, double ym, double yp,
+ double value) const throw()
+{
+  const Config * config = cello::config();
+
+  const int IX = (axis_+1) % 3;
+  const int IY = (axis_+2) % 3;
+
+  const double dxm = config->domain_lower[IX];
+  const double dym = config->domain_lower[IY];
+  const double wx = (config->domain_upper[IX] - dxm) / nx_;
+  const double wy = (config->domain_upper[IY] - dym) / ny_;
+
+  // range of pixels overlapping the cell
+
+  const int jxm = std::max(int(floor((xm-dxm)/wx)),0);
+  const int jym = std::max(int(floor((ym-dym)/wy)),0);
+  const int jxp = std::min(int(ceil ((xp-dxm)/wx)),nx_);
+  const int jyp = std::min(int(ceil ((yp-dym)/wy)),ny_);
+
+  for (int jy=jym; jy<jyp; jy++) {
+    const double oy = std::min(yp,dym+(jy+1)*wy) - std::max(ym,dym+jy*wy);
+    if (oy <= 0.0) continue;
+    for (int jx=jxm; jx<jxp; jx++) {
+      const double ox = std::min(xp,dxm+(jx+1)*wx) - std::max(xm,dxm+jx*wx);
+      if (ox <= 0.0) continue;
+      image[jx + nx_*jy] += value * (ox*oy) / (wx*wy);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+void OutputReduce::write_dataset_
+(File * file, const std::string & name,
+ const double * values, int n1, int n2) const throw()
+{
+  const int n = n1*n2;
+  file->mem_create(n,1,1,n,1,1,0,0,0);
+  file->data_create(name.c_str(),type_double,n1,n2,1,1);
+  file->data_write((void *)values);
+  file->mem_close();
+  file->data_close();
+}
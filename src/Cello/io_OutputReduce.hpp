@@ -0,0 +1,169 @@
+// See LICENSE_CELLO file for license and copyright information
+
+/// @file     io_OutputReduce.hpp
+/// @author   James Bordner (jobordner@ucsd.edu)
+/// @date     2026-10-18
+/// @brief    [\ref Io] Declaration for the OutputReduce class
+
+#ifndef IO_OUTPUT_REDUCE_HPP
+#define IO_OUTPUT_REDUCE_HPP
+
+class Factory;
+class Config;
+
+enum reduce_output_type {
+  reduce_output_unknown,
+  reduce_output_projection,
+  reduce_output_slice,
+  reduce_output_profile,
+  reduce_output_histogram
+};
+
+class OutputReduce : public Output {
+
+  /// @class    OutputReduce
+  /// @ingroup  Io
+  /// @brief [\ref Io] class for writing in-situ reductions of fields
+  ///
+  /// Each leaf Block adds its cells to a projection or slice along
+  /// an axis, a radial profile, or a volume-weighted histogram of
+  /// each field in the field list.  The partial results are summed
+  /// along the tree of processes used for image compositing, and
+  /// the root process writes one small HDF5 file per output.
+
+public: // functions
+
+  /// Empty constructor for Charm++ pup()
+  OutputReduce() throw()
+    : reduce_type_(reduce_output_unknown),
+      axis_(axis_z),
+      nx_(0), ny_(0),
+      position_(0.0),
+      radius_(0.0),
+      bins_(0),
+      range_min_(0.0),
+      range_max_(0.0),
+      log_(false),
+      values_()
+  {
+    for (int axis=0; axis<3; axis++) center_[axis] = 0.0;
+  }
+
+  /// Create an uninitialized OutputReduce object
+  OutputReduce(int index,
+	       const Factory * factory,
+	       Config * config) throw();
+
+  /// Charm++ PUP::able declarations
+  PUPable_decl(OutputReduce);
+
+  /// Charm++ PUP::able migration constructor
+  OutputReduce (CkMigrateMessage *m)
+    : Output (m),
+      reduce_type_(reduce_output_unknown),
+      axis_(axis_z),
+      nx_(0), ny_(0),
+      position_(0.0),
+      radius_(0.0),
+      bins_(0),
+      range_min_(0.0),
+      range_max_(0.0),
+      log_(false),
+      values_()
+  {
+    for (int axis=0; axis<3; axis++) center_[axis] = 0.0;
+  }
+
+  /// CHARM++ Pack / Unpack function
+  void pup (PUP::er &p);
+
+public: // virtual functions
+
+  /// Clear the reduction arrays
+  virtual void init () throw();
+
+  /// Open (or create) a file for IO
+  virtual void open () throw()
+  { /* EMPTY: the root process creates the file in close() */ };
+
+  /// Write the reductions if the root process, and clear them
+  virtual void close () throw();
+
+  /// Add the Block's cells to the reductions
+  virtual void write_block ( const Block * block ) throw();
+
+  /// Write local field to disk
+  virtual void write_field_data
+  ( const FieldData * field_data,
+    int index_field) throw()
+  { /* EMPTY */ }
+
+  /// Write local particle to disk
+  virtual void write_particle_data
+  ( const ParticleData * particle_data,
+    int index_particle) throw()
+  { /* EMPTY */ }
+
+  /// Copy the reductions of this process's subtree to a buffer
+  virtual void prepare_remote (int * n, char ** buffer) throw();
+
+  /// Add reductions received from a child process
+  virtual void update_remote  ( int n, char * buffer) throw();
+
+  /// Free the buffer allocated in prepare_remote()
+  virtual void cleanup_remote (int * n, char ** buffer) throw();
+
+  /// Reductions are summed along a binomial tree of processes
+  virtual bool is_tree_reduce () const throw()
+  { return true; }
+
+private: // functions
+
+  /// Number of reduced values per field
+  int num_values_ () const throw()
+  { return (reduce_type_ == reduce_output_projection ||
+	    reduce_type_ == reduce_output_slice) ? nx_*ny_ : bins_; }
+
+  /// Add the value of a cell covering [xm,xp] x [ym,yp] to the
+  /// pixels it overlaps, weighted by overlap area over pixel area
+  void deposit_ (double * image,
+		 double xm, double xp, double ym, double yp,
+		 double value) const throw();
+
+  /// Write a dataset of doubles to the file
+  void write_dataset_ (File * file, const std::string & name,
+		       const double * values, int n1, int n2) const throw();
+
+private: // attributes
+
+  /// Type of reduction
+  int reduce_type_;
+
+  /// Axis of projections and slices
+  int axis_;
+
+  /// Size in pixels of projections and slices
+  int nx_, ny_;
+
+  /// Position of slices along axis_
+  double position_;
+
+  /// Center and maximum radius of profiles
+  double center_[3];
+  double radius_;
+
+  /// Number of profile or histogram bins
+  int bins_;
+
+  /// Range of histogram values, and whether bins are logarithmic
+  double range_min_;
+  double range_max_;
+  bool log_;
+
+  /// Reduced values of each field in the field list, followed for
+  /// profiles by the volume in each bin (not checkpointed)
+  std::vector<double> values_;
+
+};
+
+#endif /* IO_OUTPUT_REDUCE_HPP */
@@ -81,6 +81,28 @@ void Main::p_checkpoint(int count, std::string dir_name)
   // --------------------------------------------------
 }
 
+//----------------------------------------------------------------------
+
+void Main::p_checkpoint_memory(int count)
+{
+  count_checkpoint_++;
+  if (count_checkpoint_ >= count) {
+    count_checkpoint_ = 0;
+
+#ifdef CHARM_ENZO
+    CkCallback callback
+      (CkIndex_EnzoSimulation::r_write_checkpoint_memory(),proxy_simulation);
+#if CMK_MEM_CHECKPOINT
+    // On failure, Charm++ restarts all processes from the surviving
+    // copies and continues with the callback
+    CkStartMemCheckpoint (callback);
+#else
+    callback.send();
+#endif
+#endif
+  }
+}
+
 
 //----------------------------------------------------------------------
 
@@ -92,6 +92,9 @@ public:
 
   void p_checkpoint (int count, std::string dir_name);
 
+  /// Checkpoint to the memory of each process and a buddy process
+  void p_checkpoint_memory (int count);
+
   void p_initial_exit();
   void p_adapt_enter();
   void p_adapt_called();
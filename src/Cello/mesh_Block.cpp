@@ -77,11 +77,14 @@ Block::Block ( MsgRefine * msg )
   face_level_last_(),
   name_(""),
   index_method_(-1),
+  method_time_(0.0),
+  method_start_(0.0),
   index_solver_(),
   refresh_()
 {
   performance_start_(perf_block);
   usesAtSync = true;
+  usesAutoMeasure = ! is_load_modeled_();
   init (msg->index_,
 	msg->nx_, msg->ny_, msg->nz_,
 	msg->num_field_blocks_,
@@ -98,9 +101,7 @@ Block::Block ( MsgRefine * msg )
   msg->print();
 #endif
 
-  bool is_first_cycle = (cycle_ == cello::config()->initial_cycle);
-
-  if (is_first_cycle) {
+  if (is_initial_(msg)) {
     apply_initial_();
   } else {
     msg->update(data());
@@ -144,10 +145,13 @@ Block::Block ( process_type ip_source )
   face_level_last_(),
   name_(""),
   index_method_(-1),
+  method_time_(0.0),
+  method_start_(0.0),
   index_solver_(),
   refresh_()
 {
   usesAtSync = true;
+  usesAutoMeasure = ! is_load_modeled_();
 #ifdef TRACE_BLOCK
   {
   int v3[3];
@@ -190,9 +194,7 @@ void Block::p_set_msg_refine(MsgRefine * msg)
   }
 #endif
 
-  bool is_first_cycle =  (cycle_ == cello::config()->initial_cycle);
-
-  if (is_first_cycle) {
+  if (is_initial_(msg)) {
     apply_initial_();
   } else {
     msg->update(data());
@@ -354,7 +356,12 @@ void Block::init
 void Block::initialize()
 {
   bool is_first_cycle = (cycle_ == cello::config()->initial_cycle);
-  if (is_first_cycle && level() <= 0) {
+  bool is_restart = (cello::problem()->initial_restart() != NULL);
+
+  // When restarting, Simulation::initialize_block_array_() ends the
+  // initial phase instead, since Blocks may be at any level
+
+  if (is_first_cycle && level() <= 0 && ! is_restart) {
     CkCallback callback (CkIndex_Block::r_end_initialize(NULL), thisProxy);
 #ifdef TRACE_CONTRIBUTE    
     CkPrintf ("%s %s:%d DEBUG_CONTRIBUTE r_end_initialize()\n",
@@ -415,6 +422,7 @@ void Block::pup(PUP::er &p)
   p | face_level_last_;
   p | name_;
   p | index_method_;
+  p | method_time_;
   p | index_solver_;
   p | refresh_;
   // SKIP method_: initialized when needed
@@ -546,6 +554,20 @@ void Block::apply_initial_() throw ()
 
 //----------------------------------------------------------------------
 
+bool Block::is_initial_(const MsgRefine * msg) const throw ()
+{
+  if (cycle_ != cello::config()->initial_cycle) return false;
+
+  // Blocks refined while restarting are initialized from their
+  // parent's data rather than read
+
+  const bool is_refined = (msg->data_msg_ != NULL);
+
+  return ! (is_refined && cello::problem()->initial_restart());
+}
+
+//----------------------------------------------------------------------
+
 Block::~Block()
 { 
   Simulation * simulation = cello::simulation();
@@ -673,6 +695,8 @@ Block::Block (CkMigrateMessage *m)
     face_level_last_(),
     name_(""),
     index_method_(-1),
+    method_time_(0.0),
+    method_start_(0.0),
     index_solver_(),
     refresh_()
 {
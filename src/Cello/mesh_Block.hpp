@@ -114,6 +114,8 @@ public: // interface
     face_level_last_(),
     name_(""),
     index_method_(-1),
+    method_time_(0.0),
+    method_start_(0.0),
     index_solver_(),
     refresh_()
   {
@@ -179,6 +181,14 @@ public: // interface
   bool is_leaf() const 
   { return is_leaf_ && ! (index_.level() < 0); }
 
+  /// Set the Block's existing children, e.g. when restoring a Block
+  /// array from files
+  void set_children (const std::vector<Index> & children)
+  {
+    children_ = children;
+    is_leaf_  = children_.empty();
+  }
+
   /// Index of the Block
   const Index & index() const 
   { return index_; }
@@ -355,6 +365,8 @@ protected: // methods
   void compute_end_();
   /// Exit control compute phase
   void compute_exit_();
+  /// Add time since method_start_ to method_time_
+  void method_time_stop_();
 
 public: // methods
 
@@ -632,6 +644,11 @@ protected:
   void particle_apply_periodic_update_
   ( int nl, ParticleData * particle_list[], Refresh * refresh);
 
+  /// Transform block-local integer particle positions in particle_list[]
+  /// to the frames of the corresponding neighbor Blocks
+  void particle_apply_local_update_
+  ( int nl, ParticleData * particle_list[], Refresh * refresh);
+
   /// Scatter particles of given types in type_list, to appropriate
   /// particle_array ParticleData elements
   void particle_scatter_neighbors_
@@ -653,6 +670,11 @@ protected:
 			    Index index_list[],
 			    Refresh * refresh);
 
+  /// Compress particle batches whose storage efficiency has dropped
+  /// below Particle:compress_threshold after migration, and record
+  /// batch statistics for performance output
+  void particle_compress_ (Refresh * refresh);
+
   //--------------------------------------------------
   // STOPPING
   //--------------------------------------------------
@@ -698,6 +720,10 @@ protected:
   void stopping_enter_();
   void stopping_begin_();
   void stopping_balance_();
+
+  /// Whether Balance:weight_* parameters define a Block load model
+  /// instead of Charm++'s measured load
+  bool is_load_modeled_() const;
   void stopping_exit_();
 
 public:
@@ -777,6 +803,14 @@ public: // virtual functions
 
   void ResumeFromSync();
 
+  /// Report the modeled Block load to the Charm++ load balancer
+  /// (called instead of automatic measurement if usesAutoMeasure
+  /// is false)
+  virtual void UserSetLBLoad();
+
+  /// Return the modeled Block load used for load balancing
+  double load_model() const;
+
   FieldFace * create_face
   (int if3[3], int ic3[3], bool lg3[3],
    int refresh_type,
@@ -843,6 +877,10 @@ protected: // functions
   /// Update face_level_[] for coarsened Block
   void coarsen_face_level_update_ (Index index_child);
 
+  /// Return whether to apply initial conditions to the new Block,
+  /// rather than data sent with its MsgRefine
+  bool is_initial_(const MsgRefine * msg) const throw();
+
   /// Apply all initial conditions to this Block
   void apply_initial_() throw();
 
@@ -986,6 +1024,12 @@ protected: // attributes
   /// Index of currently-active Method
   int index_method_;
 
+  /// Wall-clock time spent in Method::compute() during the last cycle
+  double method_time_;
+
+  /// Start time of the current Method::compute(), or 0.0 if not timing
+  double method_start_;
+
   /// Stack of currently active solvers
   std::vector<int> index_solver_;
   
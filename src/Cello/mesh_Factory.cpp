@@ -207,7 +207,8 @@ void Factory::create_block
  int cycle, double time, double dt,
  int narray, char * array, int refresh_type,
  int num_face_level, int * face_level,
- Simulation * simulation
+ Simulation * simulation,
+ int ip_insert
  ) const throw()
 {
 
@@ -233,6 +234,6 @@ void Factory::create_block
   msg->set_data_msg (data_msg);
 
   cello::simulation()->set_msg_refine (index,msg);
-  block_array[index].insert (process_type(CkMyPe()));
+  block_array[index].insert (process_type(CkMyPe()), ip_insert);
 }
 
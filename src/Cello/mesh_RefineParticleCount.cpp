@@ -53,13 +53,35 @@ int RefineParticleCount::apply ( Block * block ) throw ()
   const int nb = particle.num_batches (it);
   const int dp = particle.stride(it,ia_x);
 
+  // block-local integer positions are in-block if in [-PMAX,PMAX]
+
+  const bool is_int = (particle.position_int_max(it) != 0);
+  std::vector<double> u[3];
+
   size_t count = 0;
 
   for (int ib=0; ib<nb; ib++) {
 
     const int np = particle.num_particles (it,ib);
 
-    if (rank == 1) {
+    if (is_int) {
+
+      double * u3[3] = { NULL, NULL, NULL };
+      for (int axis=0; axis<rank; axis++) {
+	u[axis].resize(np);
+	u3[axis] = u[axis].data();
+      }
+      particle.position (it,ib,u3[0],u3[1],u3[2]);
+
+      for (int ip=0; ip<np; ip++) {
+	bool in = true;
+	for (int axis=0; axis<rank; axis++) {
+	  in = in && (-1.0 <= u3[axis][ip] && u3[axis][ip] <= 1.0);
+	}
+	if (in) ++count;
+      }
+
+    } else if (rank == 1) {
 
       double * xa = (double *) particle.attribute_array (it,ia_x,ib);
 
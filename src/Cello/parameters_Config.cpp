@@ -44,6 +44,9 @@ void Config::pup (PUP::er &p)
   // Balance
 
   p | balance_schedule_index;
+  p | balance_weight_cells;
+  p | balance_weight_particles;
+  p | balance_weight_time;
 
   // Boundary
 
@@ -74,6 +77,7 @@ void Config::pup (PUP::er &p)
   p | field_prolong;
   p | field_restrict;
   p | field_group_list;
+  p | field_compress_level;
 
   // Initial
 
@@ -81,6 +85,7 @@ void Config::pup (PUP::er &p)
   p | initial_list;
   p | initial_cycle;
   p | initial_time;
+  p | initial_file_dir;
   p | initial_trace_name;
   p | initial_trace_field;
   p | initial_trace_mpp;
@@ -146,7 +151,25 @@ void Config::pup (PUP::er &p)
   p | output_dir;
   p | output_dir_global;
   p | output_stride_write;
-  p | output_stride_wait;
+  p | output_link_name;
+  p | output_particle_layout;
+  p | output_field_layout;
+  p | output_async;
+  p | output_async_max_mb;
+  p | output_compress_level;
+  p | output_compress_shuffle;
+  p | output_incremental;
+  p | output_full_interval;
+  p | output_memory;
+  p | output_reduce_type;
+  p | output_reduce_size;
+  p | output_reduce_position;
+  p | output_reduce_center;
+  p | output_reduce_radius;
+  p | output_reduce_bins;
+  p | output_reduce_range;
+  p | output_reduce_log;
+  p | output_chunk_size;
   p | output_field_list;
   p | output_particle_list;
   p | output_name;
@@ -172,6 +195,9 @@ void Config::pup (PUP::er &p)
   PUParray (p,particle_attribute_position,3);
   PUParray (p,particle_attribute_velocity,3);
   p | particle_batch_size;
+  p | particle_type_batch_size;
+  p | particle_sort_threshold;
+  p | particle_compress_threshold;
   p | particle_group_list;
 
   // Performance
@@ -375,6 +401,13 @@ void Config::read_balance_ (Parameters * p) throw()
   } else {
     balance_schedule_index = -1;
   }
+
+  // Block load model reported to the Charm++ load balancer: if all
+  // weights are zero then Charm++'s measured CPU time is used
+
+  balance_weight_cells     = p->value ("Balance:weight_cells",    0.0);
+  balance_weight_particles = p->value ("Balance:weight_particles",0.0);
+  balance_weight_time      = p->value ("Balance:weight_time",     0.0);
   
 }  
 
@@ -520,6 +553,18 @@ void Config::read_field_ (Parameters * p) throw()
 
   }
 
+  // Field compression level in data output, overriding the Output's
+  // compress_level if not -1
+
+  field_compress_level.resize(num_fields);
+
+  for (int index_field=0; index_field<num_fields; index_field++) {
+
+    param = std::string("Field:") + field_list[index_field] + ":compress_level";
+
+    field_compress_level[index_field] = p->value_integer(param,-1);
+  }
+
   // Add fields to groups (Field : <field_name> : group_list)
 
   field_group_list.resize(num_fields);
@@ -616,6 +661,8 @@ void Config::read_initial_ (Parameters * p) throw()
 
   }
 
+  initial_file_dir = p->value_string ("Initial:file:dir","");
+
   initial_trace_name = p->value_string ("Initial:trace:name","trace");
   initial_trace_field = p->value_string ("Initial:trace:field","");
   initial_trace_mpp = p->value_float ("Initial:trace:mass_per_particle",0.0);
@@ -794,7 +841,25 @@ void Config::read_output_ (Parameters * p) throw()
   output_schedule_index.resize(num_output);
   output_dir.resize(num_output);
   output_stride_write.resize(num_output);
-  output_stride_wait.resize(num_output);
+  output_link_name.resize(num_output);
+  output_particle_layout.resize(num_output);
+  output_field_layout.resize(num_output);
+  output_async.resize(num_output);
+  output_async_max_mb.resize(num_output);
+  output_compress_level.resize(num_output);
+  output_compress_shuffle.resize(num_output);
+  output_incremental.resize(num_output);
+  output_full_interval.resize(num_output);
+  output_memory.resize(num_output);
+  output_reduce_type.resize(num_output);
+  output_reduce_size.resize(num_output);
+  output_reduce_position.resize(num_output);
+  output_reduce_center.resize(num_output);
+  output_reduce_radius.resize(num_output);
+  output_reduce_bins.resize(num_output);
+  output_reduce_range.resize(num_output);
+  output_reduce_log.resize(num_output);
+  output_chunk_size.resize(num_output);
   output_field_list.resize(num_output);
   output_particle_list.resize(num_output);
   output_name.resize(num_output);
@@ -820,7 +885,89 @@ void Config::read_output_ (Parameters * p) throw()
 
     output_stride_write[index_output] = p->value_integer("stride_write",0);
 
-    output_stride_wait[index_output] = p->value_integer("stride_wait",0);
+    // All processes write concurrently: stride_wait no longer
+    // serializes writers
+
+    if (p->value_integer("stride_wait",0) > 1) {
+      WARNING1("Config::read",
+	       "Output:%s:stride_wait is ignored: "
+	       "all processes write concurrently",
+	       output_list[index_output].c_str());
+    }
+
+    // "block" writes particle attributes per Block group;
+    // "concatenate" appends them to one dataset per attribute per file
+
+    output_particle_layout[index_output] =
+      p->value_string("particle_layout","block");
+
+    ASSERT2("Config::read",
+	    "Output:%s:particle_layout \"%s\" must be "
+	    "\"block\" or \"concatenate\"",
+	    output_list[index_output].c_str(),
+	    output_particle_layout[index_output].c_str(),
+	    (output_particle_layout[index_output] == "block" ||
+	     output_particle_layout[index_output] == "concatenate"));
+
+    // "block" writes field datasets per Block group; "aggregate"
+    // writes one [block][z][y][x] dataset per field per file, with
+    // block_* index datasets, and concatenates particles
+
+    output_field_layout[index_output] =
+      p->value_string("field_layout","block");
+
+    ASSERT2("Config::read",
+	    "Output:%s:field_layout \"%s\" must be "
+	    "\"block\" or \"aggregate\"",
+	    output_list[index_output].c_str(),
+	    output_field_layout[index_output].c_str(),
+	    (output_field_layout[index_output] == "block" ||
+	     output_field_layout[index_output] == "aggregate"));
+
+    // whether Blocks are copied to a staging buffer and written while
+    // subsequent cycles proceed, and the staging memory budget
+
+    output_async[index_output] = p->value_logical("async",false);
+    output_async_max_mb[index_output] = p->value_float("async_max_mb",1024.0);
+
+    // HDF5 deflate level (0 for uncompressed), whether to shuffle
+    // bytes before compressing, and dataset chunk size (0 for the
+    // Block array size along that axis)
+
+    output_compress_level[index_output] = p->value_integer("compress_level",0);
+
+    ASSERT2("Config::read",
+	    "Output:%s:compress_level %d must be between 0 and 9",
+	    output_list[index_output].c_str(),
+	    output_compress_level[index_output],
+	    (0 <= output_compress_level[index_output] &&
+	     output_compress_level[index_output] <= 9));
+
+    output_compress_shuffle[index_output] =
+      p->value_logical("compress_shuffle",true);
+
+    // whether only Blocks whose data changed since the previous
+    // output are written, and the number of outputs between full ones
+
+    output_incremental[index_output] = p->value_logical("incremental",false);
+    output_full_interval[index_output] = p->value_integer("full_interval",10);
+
+    ASSERT2("Config::read",
+	    "Output:%s:full_interval %d must be positive",
+	    output_list[index_output].c_str(),
+	    output_full_interval[index_output],
+	    output_full_interval[index_output] > 0);
+
+    // whether a "checkpoint" Output keeps Block state in memory on
+    // each process and a buddy process instead of writing to disk
+
+    output_memory[index_output] = p->value_logical("memory",false);
+
+    output_chunk_size[index_output].resize(3);
+    for (int axis=0; axis<3; axis++) {
+      output_chunk_size[index_output][axis] =
+	p->list_value_integer(axis,"chunk_size",0);
+    }
 
     if (p->type("dir") == parameter_string) {
       output_dir[index_output].resize(1);
@@ -844,6 +991,21 @@ void Config::read_output_ (Parameters * p) throw()
       }
     }
 
+    // Shared file linking to each Block group in the per-process
+    // files (data dump only)
+
+    if (p->type("link_name") == parameter_string) {
+      output_link_name[index_output].resize(1);
+      output_link_name[index_output][0] = p->value_string("link_name","");
+    } else if (p->type("link_name") == parameter_list) {
+      int size = p->list_length("link_name");
+      if (size > 0) output_link_name[index_output].resize(size);
+      for (int i=0; i<size; i++) {
+	output_link_name[index_output][i] =
+	  p->list_value_string(i,"link_name","");
+      }
+    }
+
     // // File group (data dump only)
     // if (p->type("group") == parameter_string) {
     //   output_group[index_output].resize(1);
@@ -957,6 +1119,71 @@ void Config::read_output_ (Parameters * p) throw()
       }
 
     }
+
+    // In-situ reductions
+
+    if (output_type[index_output] == "reduce") {
+
+      // "projection" or "slice" along axis, radial "profile" about
+      // center, or volume-weighted "histogram"
+
+      output_reduce_type[index_output] = 
+	p->value_string("reduce","projection");
+
+      ASSERT2("Config::read",
+	      "Output:%s:reduce \"%s\" must be \"projection\", "
+	      "\"slice\", \"profile\", or \"histogram\"",
+	      output_list[index_output].c_str(),
+	      output_reduce_type[index_output].c_str(),
+	      (output_reduce_type[index_output] == "projection" ||
+	       output_reduce_type[index_output] == "slice" ||
+	       output_reduce_type[index_output] == "profile" ||
+	       output_reduce_type[index_output] == "histogram"));
+
+      const std::string axis = p->value_string("axis","z");
+      ASSERT2("Config::read",
+	      "Output %s axis %s must be \"x\", \"y\", or \"z\"",
+	      output_list[index_output].c_str(), axis.c_str(),
+	      axis=="x" || axis=="y" || axis=="z");
+      output_axis[index_output] = axis;
+
+      // projection and slice size in pixels, 0 for the root mesh size
+
+      output_reduce_size[index_output].resize(2);
+      output_reduce_size[index_output][0] = p->list_value_integer(0,"size",0);
+      output_reduce_size[index_output][1] = p->list_value_integer(1,"size",0);
+
+      // slice position along axis and profile center and radius;
+      // defaults are the domain center and half its smallest width
+
+      output_reduce_position[index_output] =
+	p->value_float("position",std::numeric_limits<double>::max());
+
+      output_reduce_center[index_output].resize(3);
+      for (int axis=0; axis<3; axis++) {
+	output_reduce_center[index_output][axis] =
+	  p->list_value_float(axis,"center",std::numeric_limits<double>::max());
+      }
+
+      output_reduce_radius[index_output] = p->value_float("radius",0.0);
+
+      // number of profile or histogram bins, histogram value range,
+      // and whether histogram bins are logarithmic
+
+      output_reduce_bins[index_output] = p->value_integer("bins",64);
+
+      ASSERT2("Config::read",
+	      "Output:%s:bins %d must be positive",
+	      output_list[index_output].c_str(),
+	      output_reduce_bins[index_output],
+	      output_reduce_bins[index_output] > 0);
+
+      output_reduce_range[index_output].resize(2);
+      output_reduce_range[index_output][0] = p->list_value_float(0,"range",0.0);
+      output_reduce_range[index_output][1] = p->list_value_float(1,"range",0.0);
+
+      output_reduce_log[index_output] = p->value_logical("log",false);
+    }
   }  
 
 }
@@ -971,10 +1198,16 @@ void Config::read_particle_ (Parameters * p) throw()
 
   particle_batch_size = p->value_integer("Particle:batch_size",1024);
 
+  particle_sort_threshold = p->value_float("Particle:sort_threshold",0.0);
+
+  particle_compress_threshold =
+    p->value_float("Particle:compress_threshold",0.0);
+
   num_particles = p->list_length("Particle:list"); 
 
   particle_list.resize(num_particles);
   particle_interleaved.resize(num_particles);
+  particle_type_batch_size.resize(num_particles);
   particle_constant_name.resize(num_particles);
   particle_constant_type.resize(num_particles);
   particle_constant_value.resize(num_particles);
@@ -1007,6 +1240,11 @@ void Config::read_particle_ (Parameters * p) throw()
     particle_interleaved[it] = 
       p->value_logical(type_str+":interleaved",false);
 
+    // batch size for this type, defaulting to Particle:batch_size
+
+    particle_type_batch_size[it] =
+      p->value_integer(type_str+":batch_size",particle_batch_size);
+
     // Particle:<type>:constants list elements contain name, type, and
     // value
 
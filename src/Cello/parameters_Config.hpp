@@ -39,6 +39,9 @@ public: // interface
     adapt_output(),
     adapt_schedule_index(),
     balance_schedule_index(0),
+    balance_weight_cells(0.0),
+    balance_weight_particles(0.0),
+    balance_weight_time(0.0),
     num_boundary(0),
     boundary_list(),
     boundary_type(),
@@ -56,10 +59,12 @@ public: // interface
     field_prolong(""),
     field_restrict(""),
     field_group_list(),
+    field_compress_level(),
     num_initial(0),
     initial_list(),
     initial_cycle(0),
     initial_time(0.0),
+    initial_file_dir(""),
     initial_trace_name(""),
     initial_trace_field(""),
     initial_trace_mpp(0.0),
@@ -107,7 +112,25 @@ public: // interface
     output_leaf_only(),
     output_dir(),
     output_stride_write(),
-    output_stride_wait(),
+    output_link_name(),
+    output_particle_layout(),
+    output_field_layout(),
+    output_async(),
+    output_async_max_mb(),
+    output_compress_level(),
+    output_compress_shuffle(),
+    output_incremental(),
+    output_full_interval(),
+    output_memory(),
+    output_reduce_type(),
+    output_reduce_size(),
+    output_reduce_position(),
+    output_reduce_center(),
+    output_reduce_radius(),
+    output_reduce_bins(),
+    output_reduce_range(),
+    output_reduce_log(),
+    output_chunk_size(),
     output_field_list(),
     output_particle_list(),
     output_name(),
@@ -128,6 +151,9 @@ public: // interface
     particle_attribute_name(),
     particle_attribute_type(),
     particle_batch_size(0),
+    particle_type_batch_size(),
+    particle_sort_threshold(0.0),
+    particle_compress_threshold(0.0),
     particle_group_list(),
     performance_papi_counters(),
     performance_warnings(false),
@@ -187,6 +213,9 @@ public: // interface
       adapt_output(),
       adapt_schedule_index(),
       balance_schedule_index(-1),
+      balance_weight_cells(0.0),
+      balance_weight_particles(0.0),
+      balance_weight_time(0.0),
       num_boundary(0),
       boundary_list(),
       boundary_type(),
@@ -204,10 +233,12 @@ public: // interface
       field_prolong(""),
       field_restrict(""),
       field_group_list(),
+      field_compress_level(),
       num_initial(0),
       initial_list(),
       initial_cycle(0),
       initial_time(0.0),
+      initial_file_dir(""),
       initial_trace_name(""),
       initial_trace_field(""),
       initial_trace_mpp(0.0),
@@ -255,7 +286,25 @@ public: // interface
       output_leaf_only(),
       output_dir(),
       output_stride_write(),
-      output_stride_wait(),
+      output_link_name(),
+      output_particle_layout(),
+      output_field_layout(),
+      output_async(),
+      output_async_max_mb(),
+      output_compress_level(),
+      output_compress_shuffle(),
+      output_incremental(),
+      output_full_interval(),
+      output_memory(),
+      output_reduce_type(),
+      output_reduce_size(),
+      output_reduce_position(),
+      output_reduce_center(),
+      output_reduce_radius(),
+      output_reduce_bins(),
+      output_reduce_range(),
+      output_reduce_log(),
+      output_chunk_size(),
       output_field_list(),
       output_particle_list(),
       output_name(),
@@ -276,6 +325,9 @@ public: // interface
       particle_attribute_name(),
       particle_attribute_type(),
       particle_batch_size(0),
+      particle_type_batch_size(),
+      particle_sort_threshold(0.0),
+      particle_compress_threshold(0.0),
       particle_group_list(),
       performance_papi_counters(),
       performance_warnings(false),
@@ -353,6 +405,9 @@ public: // attributes
   // Balance (dynamic load balancing)
 
   int                        balance_schedule_index;
+  double                     balance_weight_cells;
+  double                     balance_weight_particles;
+  double                     balance_weight_time;
 
   // Boundary
 
@@ -384,6 +439,7 @@ public: // attributes
   std::string                field_prolong;
   std::string                field_restrict;
   std::vector< std::vector<std::string> >  field_group_list;
+  std::vector<int>           field_compress_level;
 
   // Initial
 
@@ -392,6 +448,8 @@ public: // attributes
   int                        initial_cycle;
   double                     initial_time;
 
+  std::string                initial_file_dir;
+
   std::string                initial_trace_name;
   std::string                initial_trace_field;
   double                     initial_trace_mpp;
@@ -457,7 +515,25 @@ public: // attributes
   std::vector < std::vector <std::string> >  output_dir;
   std::string                 output_dir_global;
   std::vector < int >         output_stride_write;
-  std::vector < int >         output_stride_wait;
+  std::vector < std::vector <std::string> >  output_link_name;
+  std::vector < std::string > output_particle_layout;
+  std::vector < std::string > output_field_layout;
+  std::vector < char >        output_async;
+  std::vector < double>       output_async_max_mb;
+  std::vector < int >         output_compress_level;
+  std::vector < char >        output_compress_shuffle;
+  std::vector < char >        output_incremental;
+  std::vector < int >         output_full_interval;
+  std::vector < char >        output_memory;
+  std::vector < std::string > output_reduce_type;
+  std::vector < std::vector <int> > output_reduce_size;
+  std::vector < double >      output_reduce_position;
+  std::vector < std::vector <double> > output_reduce_center;
+  std::vector < double >      output_reduce_radius;
+  std::vector < int >         output_reduce_bins;
+  std::vector < std::vector <double> > output_reduce_range;
+  std::vector < char >        output_reduce_log;
+  std::vector < std::vector <int> > output_chunk_size;
   std::vector < std::vector <std::string> >  output_field_list;
   std::vector < std::vector <std::string> > output_particle_list;
   std::vector < std::vector <std::string> >  output_name;
@@ -486,6 +562,9 @@ public: // attributes
   std::vector <int>          particle_attribute_velocity[3];
 
   int                        particle_batch_size;
+  std::vector<int>           particle_type_batch_size;
+  double                     particle_sort_threshold;
+  double                     particle_compress_threshold;
   std::vector< std::vector<std::string> >  particle_group_list;
 
   // Performance
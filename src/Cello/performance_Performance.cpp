@@ -105,6 +105,15 @@ Performance::new_counter ( int type, std::string  counter_name )
   counter_values_.push_back(0);
   counter_values_reduced_.push_back(0);
 
+  // Counters may be created after begin(), e.g. by Method constructors,
+  // so keep the per-region counter arrays in step
+
+  for (size_t i=0; i<region_counters_.size(); i++) {
+    if (region_counters_[i].size() > 0) {
+      region_counters_[i].resize(counter_name_.size(),0);
+    }
+  }
+
 #ifdef CONFIG_USE_PAPI  
   if (type == counter_type_papi) {
     papi_.add_event(counter_name);
@@ -62,6 +62,15 @@ public: // virtual functions
   virtual bool expects_blocks_allocated() const throw()
   { return true; }
 
+  /// Return whether enforce_block() restores Blocks from a previous
+  /// run, in which case create_blocks() creates the Block array
+  virtual bool is_restart() const throw()
+  { return false; }
+
+  /// Insert the Blocks that this process restores
+  virtual void create_blocks (Hierarchy * hierarchy) throw()
+  { }
+
 protected: // functions
 
 
@@ -12,11 +12,17 @@
 //----------------------------------------------------------------------
 
 InitialFile::InitialFile
-(Parameters * parameters,
+(std::string dir,
  int cycle, double time) throw ()
   : Initial (cycle,time),
-    parameters_(parameters),
-    input_(0)
+    dir_(dir),
+    input_(NULL),
+    file_name_(""),
+    block_file_(),
+    block_data_(),
+    input_data_(NULL),
+    file_data_name_(""),
+    block_index_()
 {
 }
 
@@ -24,7 +30,8 @@ InitialFile::InitialFile
 
 InitialFile::~InitialFile() throw()
 {
-  delete input_; input_ = 0;
+  delete input_; input_ = NULL;
+  delete input_data_; input_data_ = NULL;
 }
 
 //----------------------------------------------------------------------
@@ -35,13 +42,128 @@ void InitialFile::pup (PUP::er &p)
 
   Initial::pup(p);
 
-  bool up = p.isUnpacking();
+  // Blocks are only read in the initial cycle, so the open Input and
+  // the Block lists are not needed after a checkpoint
 
-  if (up) parameters_ = new Parameters;
-  p | *parameters_;
+  p | dir_;
 
-  p | input_; // PUP::able
+}
+
+//----------------------------------------------------------------------
+
+void InitialFile::create_blocks (Hierarchy * hierarchy) throw()
+{
+  ASSERT ("InitialFile::create_blocks()",
+	  "Parameter 'Initial:file:dir' must be set",
+	  dir_ != "");
+
+  ASSERT1 ("InitialFile::create_blocks()",
+	   "Restarting with Mesh:min_level = %d < 0 is not supported",
+	   cello::config()->mesh_min_level,
+	   cello::config()->mesh_min_level >= 0);
+
+  // Read DIR/DIR.block_list, one "name file" line per Block, with
+  // the file holding the Block's data appended for Blocks unchanged
+  // in an incremental output
+
+  const size_t pos = dir_.rfind("/");
+  const std::string base = (pos == std::string::npos) ?
+    dir_ : dir_.substr(pos+1);
+  const std::string block_list = dir_ + "/" + base + ".block_list";
+
+  std::ifstream stream (block_list.c_str());
+
+  ASSERT1 ("InitialFile::create_blocks()",
+	   "Cannot open block list file %s",
+	   block_list.c_str(),
+	   stream.good());
+
+  std::vector< std::pair<std::string,std::string> > blocks;
+  std::map<std::string,std::string> block_data;
+  std::string line;
+  while (std::getline(stream,line)) {
+    std::istringstream line_stream (line);
+    std::string name, file, file_data;
+    if (! (line_stream >> name >> file)) continue;
+    blocks.push_back(std::pair<std::string,std::string>(file,name));
+    if (line_stream >> file_data) block_data[name] = file_data;
+  }
+
+  // Sort Blocks by file so that each process reads few files
+
+  std::sort(blocks.begin(),blocks.end());
+
+  const int rank = cello::rank();
+
+  for (size_t ib=0; ib<blocks.size(); ib++) {
+    block_index_.insert(index_from_name_(blocks[ib].second,rank));
+  }
+
+  // This process's contiguous range of Blocks
+
+  const int64_t nb = blocks.size();
+  const int ib0 = (nb*(CkMyPe()  )) / CkNumPes();
+  const int ib1 = (nb*(CkMyPe()+1)) / CkNumPes();
+
+  Monitor::instance()->print
+    ("Initial","restoring %d of %d Blocks from %s",
+     ib1-ib0,int(nb),block_list.c_str());
+
+  int n3[3];
+  hierarchy->root_blocks(n3,n3+1,n3+2);
+
+  int nx,ny,nz;
+  hierarchy->root_size(&nx,&ny,&nz);
+  nx /= n3[0];
+  ny /= n3[1];
+  nz /= n3[2];
+
+  for (int ib=ib0; ib<ib1; ib++) {
+
+    const std::string & name = blocks[ib].second;
 
+    const Index index = index_from_name_(name,rank);
+
+    // Face levels of neighboring leaf Blocks
+
+    int face_level[27];
+    for (int i=0; i<27; i++) face_level[i] = index.level();
+
+    const int rx = (rank >= 1) ? 1 : 0;
+    const int ry = (rank >= 2) ? 1 : 0;
+    const int rz = (rank >= 3) ? 1 : 0;
+    int if3[3];
+    for (if3[0]=-rx; if3[0]<=rx; if3[0]++) {
+      for (if3[1]=-ry; if3[1]<=ry; if3[1]++) {
+	for (if3[2]=-rz; if3[2]<=rz; if3[2]++) {
+	  if (if3[0] || if3[1] || if3[2]) {
+	    face_level[IF3(if3)] = face_level_(index,if3,n3);
+	  }
+	}
+      }
+    }
+
+    block_file_[name] = blocks[ib].first;
+    if (block_data.count(name) > 0) block_data_[name] = block_data[name];
+
+    // Insert the Block with the initial cycle so that enforce_block()
+    // is called to read it.  The Block must be created on this
+    // process, not on its home process in the Block array's map,
+    // since only this process has its file in block_file_
+
+    hierarchy->factory()->create_block
+      (NULL,
+       hierarchy->block_array(),
+       index,
+       nx,ny,nz,
+       1,
+       0,
+       cycle_,time_,0.0,
+       0, NULL, refresh_same,
+       27, face_level,
+       cello::simulation(),
+       CkMyPe());
+  }
 }
 
 //----------------------------------------------------------------------
@@ -52,72 +174,180 @@ void InitialFile::enforce_block
  const Hierarchy  * hierarchy
  ) throw()
 {
-  ASSERT ("InitialFile::enforce_block",
-	  "Input block is expected to be NULL",
-	  block == 0);
+  std::map<std::string,std::string>::iterator it_block =
+    block_file_.find(block->name());
 
-  if (! input_) 
-    input_ = new InputData (hierarchy->factory());
+  ASSERT2 ("InitialFile::enforce_block()",
+	   "Block %s is not listed in %s",
+	   block->name().c_str(), dir_.c_str(),
+	   it_block != block_file_.end());
 
-  if (! input_->is_open() ) {
+  // Open the Block's file unless already open: local Blocks are
+  // sorted by file, so each file is usually opened once
 
-    std::string              file_name = "";
-    std::vector<std::string> file_args;
+  const std::string file_name = dir_ + "/" + it_block->second;
 
-    get_filename_(&file_name,&file_args);
+  if (! input_) input_ = new InputData (hierarchy->factory());
 
+  if (! input_->is_open() || file_name != file_name_) {
+    file_name_ = file_name;
+    input_->set_filename (file_name_, std::vector<std::string>());
     input_->open();
+  }
+
+  // Read Block meta data, including its cycle, time, and timestep
+
+  input_->read_block (block,block->name());
+
+  ASSERT3 ("InitialFile::enforce_block()",
+	   "Block %s was written in cycle %d: set 'Initial:cycle' to %d",
+	   block->name().c_str(),block->cycle(),block->cycle(),
+	   block->cycle() == cycle_);
+
+  block->set_state (block->cycle(),block->time(),block->dt(),false);
+
+  cello::simulation()->set_time(block->time());
+
+  // Read fields and particles, from an earlier output's file if the
+  // Block was unchanged in an incremental output
+
+  Input * input = input_;
+
+  std::map<std::string,std::string>::iterator it_data =
+    block_data_.find(block->name());
+
+  if (it_data != block_data_.end()) {
+
+    const std::string file_data = dir_ + "/" + it_data->second;
 
+    if (! input_data_) input_data_ = new InputData (hierarchy->factory());
+
+    if (! input_data_->is_open() || file_data != file_data_name_) {
+      file_data_name_ = file_data;
+      input_data_->set_filename (file_data_name_, std::vector<std::string>());
+      input_data_->open();
+    }
+
+    input = input_data_;
+    block_data_.erase(it_data);
   }
 
-  INCOMPLETE("InitialFile::enforce_block");
+  Field field = block->data()->field();
 
-  File * file = input_->file();
-  int num_blocks = file->group_count();
+  for (int index_field=0; index_field<field.field_count(); index_field++) {
+    if (field.is_permanent(index_field)) {
+      input->read_field (block,index_field);
+    }
+  }
 
-  for (int i = 0; i<num_blocks; i++) {
+  Particle particle = block->data()->particle();
 
-    std::string block_name = file->group_name(i).c_str();
+  int count = particle.num_particles();
+  for (int it=0; it<particle.num_types(); it++) {
+    input->read_particle (block,it);
+  }
+  count = particle.num_particles() - count;
+
+  cello::simulation()->data_insert_particles(count);
 
-    input_->read_block(0,block_name);
+  // Restore the Block's children
 
+  std::vector<Index> children;
+
+  ItChild it_child (cello::rank());
+  int ic3[3];
+  while (it_child.next(ic3)) {
+    const Index index_child = block->index().index_child(ic3);
+    if (block_index_.count(index_child) > 0) children.push_back(index_child);
+  }
+
+  block->set_children(children);
+
+  // Close the file after the last local Block
+
+  block_file_.erase(it_block);
+
+  if (block_file_.empty()) {
+    delete input_;
+    input_ = NULL;
+    file_name_ = "";
+    delete input_data_;
+    input_data_ = NULL;
+    file_data_name_ = "";
   }
 }
 
 //----------------------------------------------------------------------
 
-void InitialFile::get_filename_
-(
- std::string * file_name,
- std::vector<std::string> * file_args
- ) throw()
+Index InitialFile::index_from_name_
+(const std::string & name, int rank) const throw()
 {
-  // parameter: Initial : name
+  // Inverse of Block::name(): "B" followed by each axis' array bits
+  // and ":"-prefixed tree bits, with axes separated by "_"
 
-  parameters_->group_set(0,"Initial");
+  int array[3] = {0,0,0};
+  std::string tree[3];
 
-  if (parameters_->type("name") == parameter_string) {
+  size_t pos = 1;
+  for (int axis=0; axis<rank; axis++) {
 
-    *file_name = parameters_->value_string("name","");
-     
-  } else if (parameters_->type("name") == parameter_list) {
+    const size_t end = (axis < rank-1) ? name.find("_",pos) : name.size();
 
-    int list_length = parameters_->list_length("name");
+    ASSERT1 ("InitialFile::index_from_name_()",
+	     "Cannot parse Block name %s",
+	     name.c_str(),
+	     name[0] == 'B' && end != std::string::npos);
 
-    *file_name = parameters_->list_value_string(0,"name","");
+    const std::string bits = name.substr(pos,end-pos);
+    const size_t colon = bits.find(":");
 
-    for (int index = 1; index<list_length; index++) {
-      file_args->push_back(parameters_->list_value_string(index,"name",""));
+    const std::string bits_array = bits.substr(0,colon);
+    for (size_t i=0; i<bits_array.size(); i++) {
+      array[axis] = 2*array[axis] + (bits_array[i] == '1' ? 1 : 0);
     }
+    if (colon != std::string::npos) tree[axis] = bits.substr(colon+1);
 
-  } else {
+    pos = end + 1;
+  }
 
-    ERROR1("InitialFile::enforce_block",
-	   "Bad type %d for 'Initial : name' parameter",
-	   parameters_->type("name"));
+  Index index (array[0],array[1],array[2]);
 
+  const int level = tree[0].size();
+
+  index.set_level(level);
+
+  for (int i=0; i<level; i++) {
+    const int icx =              (tree[0][i] == '1') ? 1 : 0;
+    const int icy = (rank > 1 && tree[1][i] == '1') ? 1 : 0;
+    const int icz = (rank > 2 && tree[2][i] == '1') ? 1 : 0;
+    index.set_child(i+1,icx,icy,icz);
   }
 
-  input_->set_filename (*file_name, *file_args);
+  return index;
+}
+
+//----------------------------------------------------------------------
+
+int InitialFile::face_level_
+(Index index, const int if3[3], const int n3[3]) const throw()
+{
+  const int level = index.level();
+
+  const Index index_neighbor = index.index_neighbor(if3,n3);
+
+  if (block_index_.count(index_neighbor) == 0) {
 
+    // neighbor is part of a coarser leaf
+
+    return level - 1;
+
+  } else {
+
+    // neighbor is a leaf unless it has children
+
+    const Index index_child = index_neighbor.index_child(0,0,0);
+
+    return (block_index_.count(index_child) > 0) ? level + 1 : level;
+
+  }
 }
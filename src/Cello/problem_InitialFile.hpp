@@ -5,7 +5,7 @@
 /// @date     Tue Jan  4 19:26:38 PST 2011
 /// @brief    [\ref Problem] Declaration of the InitialFile class
 ///
-/// 
+///
 
 #ifndef METHOD_INITIAL_FILE_HPP
 #define METHOD_INITIAL_FILE_HPP
@@ -17,16 +17,34 @@ class InitialFile : public Initial {
   /// @brief    [\ref Problem] Declaration of the InitialFile class
   ///
   /// This class is used to define initial conditions by reading in
-  /// data from files
+  /// data from files: the directory of a "data" Output, whose
+  /// DIR.block_list file lists each Block and the file containing it.
+  /// Each process creates and reads a contiguous range of the Blocks
+  /// sorted by file, so the number of processes may differ from the
+  /// run that wrote the files.
+  ///
+  /// Blocks unchanged in an incremental "data" Output are listed with
+  /// a third entry naming the earlier output's file that holds their
+  /// fields and particles, relative to the directory.
 
 
 public: // interface
 
   /// CHARM++ constructor
-  InitialFile() throw() { }
+  InitialFile() throw()
+    : Initial(),
+      dir_(""),
+      input_(NULL),
+      file_name_(""),
+      block_file_(),
+      block_data_(),
+      input_data_(NULL),
+      file_data_name_(""),
+      block_index_()
+  { }
 
   /// Constructor
-  InitialFile(Parameters * parameters, 
+  InitialFile(std::string dir,
 	      int cycle, double time) throw();
 
   /// Destructor
@@ -36,16 +54,19 @@ public: // interface
 
   InitialFile(CkMigrateMessage *m)
     : Initial (m),
-      parameters_(NULL),
-      input_(NULL)
-    
+      dir_(""),
+      input_(NULL),
+      file_name_(""),
+      block_file_(),
+      block_data_(),
+      input_data_(NULL),
+      file_data_name_(""),
+      block_index_()
   { }
 
   /// CHARM++ Pack / Unpack function
   void pup (PUP::er &p);
 
-  /// Read initialization values from Initial group in parameter file
-
   /// Enforce initial conditions for the given Block
 
   virtual void enforce_block (Block            * block,
@@ -55,18 +76,48 @@ public: // interface
   virtual bool expects_blocks_allocated() const throw()
   { return false; }
 
+  /// InitialFile restores Blocks written by a "data" Output
+  virtual bool is_restart() const throw()
+  { return true; }
+
+  /// Insert the Blocks that this process reads
+  virtual void create_blocks (Hierarchy * hierarchy) throw();
+
 private: // functions
 
-  void get_filename_(std::string * file_name,
-		     std::vector<std::string> * file_args) throw();
+  /// Return the Index of the Block with the given name
+  Index index_from_name_ (const std::string & name, int rank) const throw();
+
+  /// Return the level of the leaf Blocks adjacent to the given face
+  int face_level_ (Index index, const int if3[3], const int n3[3])
+    const throw();
 
 private: // attributes
 
-  /// Parameters object
-  Parameters * parameters_;
+  /// Directory of the "data" Output to read
+  std::string dir_;
 
-  /// Associated Input object
+  /// Input object for the currently open file
   Input * input_;
+
+  /// Name of the file open in input_
+  std::string file_name_;
+
+  /// File containing each local Block not yet read
+  std::map<std::string,std::string> block_file_;
+
+  /// File containing the data of each local Block not yet read, if it
+  /// differs from the Block's file in an incremental output
+  std::map<std::string,std::string> block_data_;
+
+  /// Input object for the currently open data file
+  Input * input_data_;
+
+  /// Name of the file open in input_data_
+  std::string file_data_name_;
+
+  /// Indices of all Blocks in the files, leaf and non-leaf
+  std::set<Index> block_index_;
 };
 
 #endif /* METHOD_INITIAL_FILE_HPP */
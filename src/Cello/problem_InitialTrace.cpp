@@ -93,7 +93,7 @@ void InitialTrace::uniform_placement_
   const int ia_z = particle.attribute_index (it,"z");
 
   const bool have_id = (ia_id >= 0);
-  const int np = particle.batch_size();
+  const int np = particle.batch_size(it);
 
   int ib=0;  // batch counter
   int ip=0;  // particle counter 
@@ -234,7 +234,7 @@ void InitialTrace::density_placement_
 
   const bool have_id = (ia_id >= 0);
   
-  const int npb = particle.batch_size();
+  const int npb = particle.batch_size(it);
 
   int ib=0;  // batch counter
   int ipb=0;  // particle / batch counter 
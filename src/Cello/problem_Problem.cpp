@@ -602,9 +602,9 @@ Initial * Problem::create_initial_
   Initial * initial = NULL;
 
   if (type == "file") {
-    initial = new InitialFile (parameters,
+    initial = new InitialFile (config->initial_file_dir,
 			       config->initial_cycle,
-			       config->initial_time);;
+			       config->initial_time);
   } else if (type == "value") {
     initial = new InitialValue(parameters,
 			       config->initial_cycle,
@@ -896,6 +896,11 @@ Output * Problem::create_output_
     output = new OutputCheckpoint (index,factory,
 				   config,CkNumPes());
 
+  } else if (name == "reduce") {
+
+    output = new OutputReduce (index,factory,
+			       config);
+
   }
 
   return output;
@@ -99,6 +99,16 @@ public: // interface
     return (i < initial_list_.size()) ? initial_list_[i] : NULL; 
   }
 
+  /// Return the initialization object that restores Blocks from a
+  /// previous run, or NULL if none
+  Initial * initial_restart() const throw()
+  {
+    for (size_t i=0; i<initial_list_.size(); i++) {
+      if (initial_list_[i]->is_restart()) return initial_list_[i];
+    }
+    return NULL;
+  }
+
   /// Return the ith physics object
   Physics * physics(size_t i) const throw()
   {
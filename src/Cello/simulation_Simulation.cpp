@@ -58,6 +58,7 @@ Simulation::Simulation
   sync_output_write_(),
   sync_new_output_start_(),
   sync_new_output_next_(),
+  particle_stats_(),
   index_output_(-1)
 {
   for (int i=0; i<256; i++) dir_checkpoint_[i] = '\0';
@@ -119,6 +120,7 @@ Simulation::Simulation()
   sync_output_write_(),
   sync_new_output_start_(),
   sync_new_output_next_(),
+  particle_stats_(),
   index_output_(-1)
 {
   for (int i=0; i<256; i++) dir_checkpoint_[i] = '\0';
@@ -168,6 +170,7 @@ Simulation::Simulation (CkMigrateMessage *m)
     sync_output_write_(),
     sync_new_output_start_(),
     sync_new_output_next_(),
+    particle_stats_(),
     index_output_(-1)
 
 {
@@ -559,6 +562,13 @@ void Simulation::initialize_data_descr_() throw()
   // Set particle batch size
   particle_descr_->set_batch_size(config_->particle_batch_size);
 
+  // Set disorder threshold for sorting particles by cell
+  particle_descr_->set_sort_threshold(config_->particle_sort_threshold);
+
+  // Set efficiency threshold for compressing particles after migration
+  particle_descr_->set_compress_threshold
+    (config_->particle_compress_threshold);
+
   // Add particle types
 
   // ... first map attribute scalar type name to type_enum int
@@ -571,6 +581,10 @@ void Simulation::initialize_data_descr_() throw()
 
     particle_descr_->new_type (config_->particle_list[it]);
 
+    // Set batch size for the type before its attributes are added
+    particle_descr_->set_batch_size
+      (it,config_->particle_type_batch_size[it]);
+
     // Add particle constants
     int nc = config_->particle_constant_name[it].size();
     for (int ic=0; ic<nc; ic++) {
@@ -733,6 +747,23 @@ void Simulation::initialize_balance_() throw()
 
 void Simulation::initialize_block_array_() throw()
 {
+  Initial * initial_restart = problem_->initial_restart();
+
+  if (initial_restart) {
+
+    // Restarting: every process creates the Blocks it reads, and
+    // Blocks exit the initial phase once all are created and read
+
+    initial_restart->create_blocks (hierarchy_);
+
+    if (CkMyPe() == 0) {
+      hierarchy_->block_array().doneInserting();
+      CkStartQD(CkCallback (CkIndex_Main::p_initial_exit(),proxy_main));
+    }
+
+    return;
+  }
+
   bool allocate_blocks = (CkMyPe() == 0);
 
   // Don't allocate blocks if reading data from files
@@ -843,6 +874,19 @@ void Simulation::data_delete_particles(int64_t count)
 
 //----------------------------------------------------------------------
 
+void Simulation::data_particle_stats
+(int it, int64_t np, int64_t nb, bool compressed)
+{
+  if (particle_stats_.size() < 4*(it+1)) particle_stats_.resize(4*(it+1),0);
+  int64_t * stats = &particle_stats_[4*it];
+  if (np > 0) ++stats[0];
+  stats[1] += np;
+  stats[2] += nb;
+  if (compressed) ++stats[3];
+}
+
+//----------------------------------------------------------------------
+
 void Simulation::p_monitor()
 {
   monitor()-> print("", "-------------------------------------");
@@ -868,10 +912,13 @@ void Simulation::monitor_performance()
   // 5 field_face
   // 6 particle_data
   // 7 num-particles
+  // 4*NT particle storage (blocks, particles, batches, compressions)
   // NL num-blocks-<L>
   // 
+
+  const int nt = particle_descr_->num_types();
   
-  int n = 1 + 7 + ( 1 + hierarchy_->max_level()) + nr*nc;
+  int n = 1 + 7 + 4*nt + ( 1 + hierarchy_->max_level()) + nr*nc;
 
   long long * counters_region = new long long [nc];
   long long * counters_reduce = new long long [n];
@@ -888,6 +935,12 @@ void Simulation::monitor_performance()
   counters_reduce[m++] = ParticleData::counter[in];   // 6
   counters_reduce[m++] = hierarchy_->num_particles(); // 7
 
+  particle_stats_.resize(4*nt,0);
+  for (int i=0; i<4*nt; i++) {
+    counters_reduce[m++] = particle_stats_[i];
+    particle_stats_[i] = 0;
+  }
+
   for (int i=0; i<=hierarchy_->max_level(); i++) 
     counters_reduce[m++] = hierarchy_->num_blocks(i);
   
@@ -947,6 +1000,31 @@ void Simulation::r_monitor_performance(CkReductionMsg * msg)
   monitor()->print("Performance","simulation num-particles total %ld",
 		   num_particles);
 
+  // particle batch storage since the last output, with a suggested
+  // batch size: the largest power of two at most a quarter of the
+  // mean particles per occupied Block (so the partially-filled last
+  // batch wastes about 1/8 of storage or less), but at least 64
+
+  const int nt = particle_descr_->num_types();
+  for (int it=0; it<nt; it++) {
+    const long long num_blocks   = counters_reduce[m++];
+    const long long num_stored   = counters_reduce[m++];
+    const long long num_batches  = counters_reduce[m++];
+    const long long num_compress = counters_reduce[m++];
+    if (num_batches == 0) continue;
+    const std::string name = particle_descr_->type_name(it);
+    const int mb = particle_descr_->batch_size(it);
+    const double np_block = 1.0*num_stored / MAX(num_blocks,1LL);
+    int mb_suggest = 64;
+    while (2*mb_suggest <= 0.25*np_block) mb_suggest *= 2;
+    monitor()->print("Performance","particle %s efficiency %5.3f",
+		     name.c_str(), 1.0*num_stored / (num_batches*mb));
+    monitor()->print("Performance","particle %s num-compress %lld",
+		     name.c_str(), num_compress);
+    monitor()->print("Performance","particle %s batch-size %d suggested %d",
+		     name.c_str(), mb, mb_suggest);
+  }
+
   // compute total blocks and leaf blocks
   int num_total_blocks = 0;
   long long num_leaf_blocks = counters_reduce[m];;
@@ -251,14 +251,21 @@ public: // virtual functions
 
   /// Call output on Problem list of Output objects
   void output_enter ();
-  void p_output_start (int index_output)
-  { output_start (index_output); }
   /// Barrier between creating file(s) and writing to them
   void r_output_barrier(CkReductionMsg * msg);
   
   void output_start (int index_output);
   void output_exit();
 
+  /// Contribute local Block entries for the Output's shared link
+  /// file, if any
+  void output_link (int index_output);
+  /// Write the shared link file on the root process
+  void r_output_link(CkReductionMsg * msg);
+
+  /// Write the next Block staged for asynchronous output, if any
+  void p_output_drain(int index_output);
+
   /// Reduce output, using p_output_write to send data to writing processes
   void s_write()
   {
@@ -274,6 +281,9 @@ public: // virtual functions
   /// Continue on to Problem::output_wait() from checkpoint
   virtual void r_write_checkpoint();
 
+  /// Continue on to Problem::output_wait() from memory checkpoint
+  virtual void r_write_checkpoint_memory();
+
   /// Receive data from non-writing process, write to disk, close, and
   /// proceed with next output
   void p_output_write (int n, char * buffer);
@@ -315,6 +325,11 @@ public: // virtual functions
   /// Remove a Particle from this local branch
   void data_delete_particles(int64_t count) ;
 
+  /// Record a Block's storage of the given particle type after
+  /// particles migrate, for reporting batch efficiency and suggested
+  /// batch sizes in monitor_performance()
+  void data_particle_stats(int it, int64_t np, int64_t nb, bool compressed);
+
   virtual void monitor_performance();
 
   void set_checkpoint(char * checkpoint)
@@ -465,6 +480,10 @@ protected: // attributes
   Sync sync_new_output_start_;
   Sync sync_new_output_next_;
 
+  /// Particle storage counts per type since the last performance
+  /// output: occupied blocks, particles, batches, and compressions
+  std::vector<int64_t> particle_stats_;
+
   /// Saved latest checkpoint directory for creating symlink
   char dir_checkpoint_[256];
 
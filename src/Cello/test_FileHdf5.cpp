@@ -570,6 +570,229 @@ PARALLEL_MAIN_BEGIN
 
   hdf5_b.file_close();
 
+  //----------------------------------------------------------------------
+  unit_func("data_append()");
+  //----------------------------------------------------------------------
+
+  // append two ranges to a root dataset, the second while a group is
+  // open, then read the concatenated dataset back
+
+  const int n1 = 30;
+  const int n2 = nx*ny - n1;
+
+  FileHdf5 hdf5_c("./","test_disk_append.h5");
+  hdf5_c.file_create();
+
+  int o1 = hdf5_c.data_append ("append",type_int,n1);
+  hdf5_c.mem_create(n1,1,1,n1,1,1,0,0,0);
+  hdf5_c.data_write (a_int);
+  hdf5_c.mem_close();
+  hdf5_c.data_close();
+
+  hdf5_c.group_chdir ("/block");
+  hdf5_c.group_create ();
+  hdf5_c.group_write_meta(&n1,"n1",type_int);
+
+  int o2 = hdf5_c.data_append ("append",type_int,n2);
+  hdf5_c.mem_create(n2,1,1,n2,1,1,0,0,0);
+  hdf5_c.data_write (a_int + n1);
+  hdf5_c.mem_close();
+  hdf5_c.data_close();
+
+  hdf5_c.group_close();
+  hdf5_c.file_close();
+
+  unit_assert (o1 == 0);
+  unit_assert (o2 == n1);
+
+  FileHdf5 hdf5_d("./","test_disk_append.h5");
+  hdf5_d.file_open();
+
+  int m_append = 0;
+  hdf5_d.data_open ("append",&type,&m_append);
+
+  unit_assert (m_append == n1 + n2);
+  unit_assert (type == type_int);
+
+  for (int i=0; i<nx*ny; i++) b_int[i] = 0;
+
+  hdf5_d.data_slice (m_append,1,1,1, n2,1,1,1, n1,0,0,0);
+  hdf5_d.mem_create(n2,1,1,n2,1,1,0,0,0);
+  hdf5_d.data_read (b_int);
+  hdf5_d.mem_close();
+  hdf5_d.data_close();
+  hdf5_d.file_close();
+
+  bool p_append = true;
+  for (int i=0; i<n2; i++) {
+    p_append = p_append && (b_int[i] == a_int[n1+i]);
+  }
+
+  unit_assert (p_append);
+
+  //----------------------------------------------------------------------
+  unit_func("data_exists()");
+  //----------------------------------------------------------------------
+
+  // root datasets are not visible from inside a group
+
+  FileHdf5 hdf5_x("./","test_disk_append.h5");
+  hdf5_x.file_open();
+
+  unit_assert (hdf5_x.data_exists ("append"));
+  unit_assert (! hdf5_x.data_exists ("missing"));
+
+  hdf5_x.group_chdir ("/block");
+  hdf5_x.group_open ();
+
+  unit_assert (! hdf5_x.data_exists ("append"));
+
+  hdf5_x.group_close();
+  hdf5_x.file_close();
+
+  //----------------------------------------------------------------------
+  unit_func("link_external()");
+  //----------------------------------------------------------------------
+
+  // link to the "/block" group written above, and read the group's
+  // contents through the link
+
+  FileHdf5 hdf5_e("./","test_disk_link.h5");
+  hdf5_e.file_create();
+  hdf5_e.link_external ("/block_link","test_disk_append.h5","/block");
+  hdf5_e.file_close();
+
+  FileHdf5 hdf5_f("./","test_disk_link.h5");
+  hdf5_f.file_open();
+  hdf5_f.group_chdir ("/block_link");
+  hdf5_f.group_open ();
+
+  int n1_link = 0;
+  hdf5_f.group_read_meta(&n1_link,"n1",&type);
+
+  unit_assert (n1_link == n1);
+
+  hdf5_f.group_close ();
+  hdf5_f.file_close();
+
+  //----------------------------------------------------------------------
+  unit_func("set_chunk()");
+  //----------------------------------------------------------------------
+
+  // write the same smooth array contiguous and chunked with shuffle
+  // and deflate, then compare file sizes and read back a chunk-aligned
+  // subvolume
+
+  const int cx = 16, cy = 16, cz = 16;
+  const int size_c = cx*cy*cz;
+
+  double * c_double = new double [size_c];
+  double * d_double = new double [size_c];
+  for (int i=0; i<size_c; i++) c_double[i] = 1.0 + 0.001*(i%cx);
+
+  FileHdf5 hdf5_g("./","test_disk_contiguous.h5");
+  hdf5_g.file_create();
+  hdf5_g.mem_create(cx,cy,cz,cx,cy,cz,0,0,0);
+  hdf5_g.data_create ("double",type_double,cz,cy,cx,1);
+  hdf5_g.data_write (c_double);
+  hdf5_g.data_close ();
+  hdf5_g.file_close();
+
+  FileHdf5 hdf5_h("./","test_disk_chunked.h5");
+  hdf5_h.set_compress (6,true);
+  hdf5_h.set_chunk (cz/2,cy/2,cx/2);
+  hdf5_h.file_create();
+  hdf5_h.mem_create(cx,cy,cz,cx,cy,cz,0,0,0);
+  hdf5_h.data_create ("double",type_double,cz,cy,cx,1);
+  hdf5_h.data_write (c_double);
+  hdf5_h.data_close ();
+  hdf5_h.file_close();
+
+  struct stat stat_g, stat_h;
+  stat ("./test_disk_contiguous.h5",&stat_g);
+  stat ("./test_disk_chunked.h5",&stat_h);
+
+  unit_assert (stat_h.st_size < stat_g.st_size);
+
+  FileHdf5 hdf5_i("./","test_disk_chunked.h5");
+  hdf5_i.file_open();
+
+  int mz_c,my_c,mx_c;
+  hdf5_i.data_open ("double",&type,&mz_c,&my_c,&mx_c);
+
+  unit_assert (mx_c == cx && my_c == cy && mz_c == cz);
+
+  for (int i=0; i<size_c; i++) d_double[i] = 0.0;
+
+  // read the upper octant
+
+  const int hx = cx/2, hy = cy/2, hz = cz/2;
+  hdf5_i.data_slice (cz,cy,cx,1, hz,hy,hx,1, hz,hy,hx,0);
+  hdf5_i.mem_create(hx,hy,hz,hx,hy,hz,0,0,0);
+  hdf5_i.data_read (d_double);
+  hdf5_i.mem_close();
+  hdf5_i.data_close();
+  hdf5_i.file_close();
+
+  bool p_chunk = true;
+  for (int iz=0; iz<hz; iz++) {
+    for (int iy=0; iy<hy; iy++) {
+      for (int ix=0; ix<hx; ix++) {
+	const int i = ix + hx*(iy + hy*iz);
+	const int j = (ix+hx) + cx*((iy+hy) + cy*(iz+hz));
+	p_chunk = p_chunk && (d_double[i] == c_double[j]);
+      }
+    }
+  }
+
+  unit_assert (p_chunk);
+
+  //----------------------------------------------------------------------
+  unit_func("data_create() 4D");
+  //----------------------------------------------------------------------
+
+  // write three "Blocks" as one [block][z][y][x] dataset with a single
+  // write, then read back the middle Block
+
+  const int nb = 3;
+  double * e_double = new double [nb*size_c];
+  for (int i=0; i<nb*size_c; i++) e_double[i] = i;
+
+  FileHdf5 hdf5_j("./","test_disk_aggregate.h5");
+  hdf5_j.file_create();
+  hdf5_j.mem_create(nb*size_c,1,1,nb*size_c,1,1,0,0,0);
+  hdf5_j.data_create ("double",type_double,nb,cz,cy,cx,nb,cz,cy,cx);
+  hdf5_j.data_write (e_double);
+  hdf5_j.mem_close();
+  hdf5_j.data_close ();
+  hdf5_j.file_close();
+
+  FileHdf5 hdf5_k("./","test_disk_aggregate.h5");
+  hdf5_k.file_open();
+
+  int mb_j,mz_j,my_j,mx_j;
+  hdf5_k.data_open ("double",&type,&mb_j,&mz_j,&my_j,&mx_j);
+
+  unit_assert (mb_j == nb && mz_j == cz && my_j == cy && mx_j == cx);
+
+  hdf5_k.data_slice (nb,cz,cy,cx, 1,cz,cy,cx, 1,0,0,0);
+  hdf5_k.mem_create(cx,cy,cz,cx,cy,cz,0,0,0);
+  hdf5_k.data_read (d_double);
+  hdf5_k.mem_close();
+  hdf5_k.data_close();
+  hdf5_k.file_close();
+
+  bool p_aggregate = true;
+  for (int i=0; i<size_c; i++) {
+    p_aggregate = p_aggregate && (d_double[i] == e_double[size_c + i]);
+  }
+
+  unit_assert (p_aggregate);
+
+  delete [] c_double;
+  delete [] d_double;
+  delete [] e_double;
+
   //--------------------------------------------------
   // Finalize
   //--------------------------------------------------
@@ -722,14 +722,48 @@ PARALLEL_MAIN_BEGIN
   unit_assert (particle.efficiency (it_trace)   < 0.80);
   unit_assert (particle.efficiency ()           > 0.85);
 
+  // save trace x attributes in order to check compress() preserves them
+  std::vector<int32_t> trace_x;
+  {
+    const int dx = particle.stride(it_trace,ia_trace_x);
+    for (int ib=0; ib<particle.num_batches(it_trace); ib++) {
+      const int np = particle.num_particles(it_trace,ib);
+      int32_t * x = (int32_t *) particle.attribute_array(it_trace,ia_trace_x,ib);
+      for (int ip=0; ip<np; ip++) trace_x.push_back(x[ip*dx]);
+    }
+  }
+
   particle.compress(it_trace);
 
   unit_assert (particle.efficiency (it_dark,0)  > 0.99);
   unit_assert (particle.efficiency (it_dark)    > 0.85);
   unit_assert (particle.efficiency (it_trace,0) > 0.99);
-  unit_assert (particle.efficiency (it_trace)   > 0.99);
   unit_assert (particle.efficiency ()           > 0.90);
 
+  {
+    // all batches full except possibly the last, same particles in
+    // the same order
+    const int mb = particle.batch_size(it_trace);
+    const int nb = particle.num_batches(it_trace);
+    const int np = trace_x.size();
+    unit_assert (particle.num_particles(it_trace) == np);
+    unit_assert (nb == (np + mb - 1) / mb);
+    bool full = true;
+    for (int ib=0; ib<nb-1; ib++) {
+      full = full && (particle.num_particles(it_trace,ib) == mb);
+    }
+    unit_assert (full);
+    const int dx = particle.stride(it_trace,ia_trace_x);
+    bool same = true;
+    for (int i=0; i<np; i++) {
+      int ib,ip;
+      particle.index(it_trace,i,&ib,&ip);
+      int32_t * x = (int32_t *) particle.attribute_array(it_trace,ia_trace_x,ib);
+      same = same && (x[ip*dx] == trace_x[i]);
+    }
+    unit_assert (same);
+  }
+
   //--------------------------------------------------
   //   GATHER / SCATTER
   //--------------------------------------------------
@@ -1025,6 +1059,62 @@ PARALLEL_MAIN_BEGIN
 
   unit_assert (error_gather_int == 0);
 
+  //--------------------------------------------------
+  // disorder(), sort()
+  //--------------------------------------------------
+
+  {
+    const int np = p_dst.num_particles(it_dark);
+    std::vector<int64_t> key;
+    for (int ib=0; ib<nb; ib++) {
+      const int npb = p_dst.num_particles(it_dark,ib);
+      float * xa = (float *) p_dst.attribute_array(it_dark,ia_dark_x,ib);
+      float * ya = (float *) p_dst.attribute_array(it_dark,ia_dark_y,ib);
+      // reversed row-major order so the gathered particles are unsorted
+      for (int ip=0; ip<npb; ip++) {
+	const int ix = (int)(xa[ip*dx]-1);
+	const int iy = (int)(ya[ip*dx]-1);
+	key.push_back(ndx*ndy - (ix + ndx*iy));
+      }
+    }
+
+    unit_func ("disorder()");
+    unit_assert (p_dst.disorder(it_dark,&key[0]) > 0.0);
+
+    unit_func ("sort()");
+    p_dst.sort(it_dark,&key[0]);
+    unit_assert (p_dst.num_particles(it_dark) == np);
+
+    // recompute keys from the sorted attributes: x and y must still
+    // agree with each other and be in nonincreasing row-major order
+
+    std::vector<int64_t> key_sorted;
+    nb = p_dst.num_batches(it_dark);
+    bool mask_sort[ndx*ndy] = {0};
+    int error_sort_duple = 0;
+    for (int ib=0; ib<nb; ib++) {
+      const int npb = p_dst.num_particles(it_dark,ib);
+      float * xa = (float *) p_dst.attribute_array(it_dark,ia_dark_x,ib);
+      float * ya = (float *) p_dst.attribute_array(it_dark,ia_dark_y,ib);
+      for (int ip=0; ip<npb; ip++) {
+	const int ix = (int)(xa[ip*dx]-1);
+	const int iy = (int)(ya[ip*dx]-1);
+	if (mask_sort[ix+ndx*iy]) ++error_sort_duple;
+	mask_sort[ix+ndx*iy] = true;
+	key_sorted.push_back(ndx*ndy - (ix + ndx*iy));
+      }
+    }
+    unit_assert (error_sort_duple == 0);
+    unit_assert ((int)key_sorted.size() == np);
+    unit_assert (std::is_sorted(key_sorted.begin(),key_sorted.end()));
+    unit_assert (p_dst.disorder(it_dark,&key_sorted[0]) == 0.0);
+    int error_sort_mask = 0;
+    for (int i=0; i<ndx*ndy; i++) {
+      if (mask_sort[i] != mask_array[i]) ++error_sort_mask;
+    }
+    unit_assert (error_sort_mask == 0);
+  }
+
   //--------------------------------------------------
   // data_size(), save_data(), load_data() 
   //--------------------------------------------------
@@ -1051,6 +1141,169 @@ PARALLEL_MAIN_BEGIN
   delete [] buffer;
   // printf ("error_gather_int %d\n",error_gather_int);
 
+  //--------------------------------------------------
+  //   Alignment
+  //--------------------------------------------------
+
+  unit_func("attribute_array() alignment");
+
+  {
+    // unpacked batches are realigned in load_data()
+    bool aligned = true;
+    for (int ib=0; ib<new_p.num_batches(it_dark); ib++) {
+      for (int ia=0; ia<new_p.num_attributes(it_dark); ia++) {
+	uintptr_t a = (uintptr_t) new_p.attribute_array(it_dark,ia,ib);
+	aligned = aligned && (a % PARTICLE_ALIGN == 0);
+      }
+    }
+    unit_assert (aligned);
+    unit_assert (p_dst == new_p);
+  }
+
+  {
+    // batch size chosen so unpadded arrays would be misaligned
+    ParticleDescr * descr_odd = new ParticleDescr;
+    descr_odd->set_batch_size (100);
+    ParticleData data_odd;
+    Particle p_odd (descr_odd,&data_odd);
+    const int it = p_odd.new_type ("odd");
+    p_odd.new_attribute (it, "x", type_single);
+    p_odd.new_attribute (it, "i", type_int16);
+    p_odd.new_attribute (it, "v", type_double);
+    p_odd.insert_particles (it,250);
+
+    unit_func("batch_bytes()");
+    unit_assert (descr_odd->batch_bytes(it) % PARTICLE_ALIGN == 0);
+    unit_assert (descr_odd->batch_bytes(it) >= 100*(4+2+8));
+
+    unit_func("attribute_offset() alignment");
+    bool aligned = true;
+    for (int ia=0; ia<p_odd.num_attributes(it); ia++) {
+      aligned = aligned && (p_odd.attribute_offset(it,ia) % PARTICLE_ALIGN == 0);
+    }
+    unit_assert (aligned);
+
+    unit_func("attribute_array_soa()");
+    aligned = true;
+    for (int ib=0; ib<p_odd.num_batches(it); ib++) {
+      double * v = p_odd.attribute_array_soa<double>(it,2,ib);
+      aligned = aligned && ((uintptr_t) v % PARTICLE_ALIGN == 0);
+      // padding to the full batch is allocated
+      for (int ip=0; ip<100; ip++) v[ip] = ip;
+    }
+    unit_assert (aligned);
+
+    unit_func("batch_size(it)");
+    const int it_small = p_odd.new_type ("small");
+    descr_odd->set_batch_size (it_small,48);
+    p_odd.new_attribute (it_small, "m", type_double);
+    p_odd.insert_particles (it_small,100);
+    unit_assert (p_odd.batch_size(it) == 100);
+    unit_assert (p_odd.batch_size(it_small) == 48);
+    unit_assert (p_odd.num_batches(it_small) == 3);
+    unit_assert (p_odd.num_particles(it_small,2) == 4);
+    int ib,ip;
+    p_odd.index(it_small,50,&ib,&ip);
+    unit_assert (ib == 1 && ip == 2);
+    delete descr_odd;
+  }
+
+  {
+    // block-local integer positions
+    ParticleDescr * descr_int = new ParticleDescr;
+    descr_int->set_batch_size (64);
+    ParticleData data_int;
+    Particle p_int (descr_int,&data_int);
+    const int it = p_int.new_type ("int");
+    const int ia_x = p_int.new_attribute (it, "x", type_int64);
+    const int ia_y = p_int.new_attribute (it, "y", type_int32);
+    p_int.set_position (it,ia_x,ia_y);
+    const int it_f = p_int.new_type ("float");
+    const int ia_f = p_int.new_attribute (it_f, "x", type_double);
+    p_int.set_position (it_f,ia_f);
+
+    unit_func("position_int_max()");
+    unit_assert (p_int.position_int_max(it)   == PMAX_64);
+    unit_assert (p_int.position_int_max(it_f) == 0);
+
+    // u = 0, 0.25, 0.5, 0.75 along x and 1, 1.25, 1.5, 1.75 along y
+    const int np = 4;
+    p_int.insert_particles (it,np);
+    p_int.insert_particles (it_f,1);
+    int64_t * x = (int64_t *) p_int.attribute_array (it,ia_x,0);
+    int32_t * y = (int32_t *) p_int.attribute_array (it,ia_y,0);
+    const int dx = p_int.stride(it,ia_x);
+    const int dy = p_int.stride(it,ia_y);
+    for (int ip=0; ip<np; ip++) {
+      x[ip*dx] = ip*(PMAX_64/4);
+      y[ip*dy] = PMAX_32 + ip*(PMAX_32/4);
+    }
+    double * f = (double *) p_int.attribute_array (it_f,ia_f,0);
+    f[0] = 0.3;
+
+    unit_func("position_cells()");
+    const int    n3[3]  = { 8, 8, 8 };
+    const double xm3[3] = { 3.0, 3.0, 3.0 };
+    const double xp3[3] = { 5.0, 5.0, 5.0 };
+    double tx[np], ty[np];
+    p_int.position_cells (it,0,n3,xm3,xp3,tx,ty);
+    bool error_cells = false;
+    for (int ip=0; ip<np; ip++) {
+      error_cells = error_cells || (tx[ip] != 4.0 + ip);
+      error_cells = error_cells || (ty[ip] != 8.0 + ip);
+    }
+    p_int.position_cells (it_f,0,n3,xm3,xp3,tx);
+    error_cells = error_cells || (std::abs(tx[0] - 8*(0.3-3.0)/2.0) > 1e-12);
+    unit_assert (! error_cells);
+
+    unit_func("position_transform_int()");
+
+    // same-level neighbor along +y: u' = u - 2
+    const double d_same[3] = { 0.0, -2.0, 0.0 };
+    p_int.position_transform_int (it,0,d_same,0);
+    bool error_same = false;
+    for (int ip=0; ip<np; ip++) {
+      error_same = error_same || (x[ip*dx] != ip*(PMAX_64/4));
+      error_same = error_same || (y[ip*dy] != -PMAX_32 + ip*(PMAX_32/4));
+    }
+    unit_assert (! error_same);
+
+    // refine to child (1,1,0) then coarsen back to parent
+    const double d_refine[3]  = { -0.5, -0.5, 0.0 };
+    const double d_coarsen[3] = { +1.0, +1.0, 0.0 };
+    p_int.position_transform_int (it,0,d_refine,+1);
+    bool error_refine = false;
+    for (int ip=0; ip<np; ip++) {
+      error_refine = error_refine ||
+	(x[ip*dx] != -PMAX_64 + ip*(PMAX_64/2));
+    }
+    unit_assert (! error_refine);
+    p_int.position_transform_int (it,0,d_coarsen,-1);
+    bool error_coarsen = false;
+    for (int ip=0; ip<np; ip++) {
+      error_coarsen = error_coarsen || (x[ip*dx] != ip*(PMAX_64/4));
+    }
+    unit_assert (! error_coarsen);
+
+    // coarse neighbor along +x from child ic = 1, with offsets that
+    // exceed the int64 range: u' = (u - 3) / 2
+    for (int ip=0; ip<np; ip++) x[ip*dx] = PMAX_64 + ip*(PMAX_64/4);
+    const double d_coarse[3] = { -3.0, 0.0, 0.0 };
+    p_int.position_transform_int (it,0,d_coarse,-1);
+    bool error_coarse = false;
+    for (int ip=0; ip<np; ip++) {
+      error_coarse = error_coarse ||
+	(x[ip*dx] != -PMAX_64 + ip*(PMAX_64/8));
+    }
+    unit_assert (! error_coarse);
+
+    // floating-point positions are unchanged
+    p_int.position_transform_int (it_f,0,d_coarse,-1);
+    unit_assert (f[0] == 0.3);
+
+    delete descr_int;
+  }
+
   //--------------------------------------------------
   //   Grouping
   //--------------------------------------------------
@@ -37,6 +37,10 @@
 
 #include "charm_enzo.hpp"
 
+#ifdef CONFIG_USE_CKLOOP
+#  include "CkLoopAPI.h"
+#endif
+
 //----------------------------------------------------------------------
 
 extern CProxy_EnzoSimulation proxy_enzo_simulation;
@@ -50,6 +54,12 @@ PARALLEL_MAIN_BEGIN
 
   PARALLEL_INIT;
 
+#ifdef CONFIG_USE_CKLOOP
+  // Initialize CkLoop helpers on all PEs of each SMP node
+
+  CkLoop_Init();
+#endif
+
 #ifdef PNG_1_2_X
   CkPrintf ("PNG_1_2_X\n");
 #endif
@@ -199,7 +199,19 @@ public: // interface
   /// Solve the hydro equations using PPM
   int SolveHydroEquations ( enzo_float time, 
 			    enzo_float dt,
-			    bool comoving_coordinates);
+			    bool comoving_coordinates,
+			    bool native = false);
+
+  /// C++ replacement for the Fortran ppm_de() sweep driver,
+  /// specialized on rank at compile time
+  template <int RANK>
+  void ppm_de_native_
+  ( enzo_float * d, enzo_float * e,
+    enzo_float * u, enzo_float * v, enzo_float * w, enzo_float * ge,
+    int gravity, enzo_float * gr_xacc, enzo_float * gr_yacc,
+    enzo_float * gr_zacc, enzo_float dt,
+    enzo_float * dx, enzo_float * dy, enzo_float * dz,
+    enzo_float * temp, int ncolor, enzo_float * colorpt, int * coloff);
 
   /// Solve the hydro equations using Enzo 3.0 PPM
   int SolveHydroEquations3 ( enzo_float time, enzo_float dt);
@@ -240,6 +252,11 @@ public: /// entry methods
 
   //--------------------------------------------------
 
+  /// Exit Crank-Nicolson solve in EnzoMethodHeat
+  void r_method_heat_end();
+
+  //--------------------------------------------------
+
   /// EnzoSolverCg entry method: DOT ==> refresh P
   void r_solver_cg_loop_0a (CkReductionMsg * msg) ;  
 
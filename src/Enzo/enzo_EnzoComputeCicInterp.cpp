@@ -17,12 +17,18 @@ EnzoComputeCicInterp::EnzoComputeCicInterp
 (std::string     field_name,
  std::string     particle_type,
  std::string     particle_attribute,
- double          dt)
+ double          dt,
+ std::string     type)
   : it_p_ (cello::particle_descr()->type_index (particle_type)),
     ia_p_ (cello::particle_descr()->attribute_index (it_p_,particle_attribute)),
     if_ (cello::field_descr()->field_id (field_name)),
-    dt_(dt)
+    dt_(dt),
+    tsc_(type == "tsc")
 {
+  ASSERT1 ("EnzoComputeCicInterp::EnzoComputeCicInterp()",
+	   "Unknown interpolation type \"%s\": must be \"cic\" or \"tsc\"",
+	   type.c_str(),
+	   (type == "cic" || type == "tsc"));
 }
 
 //----------------------------------------------------------------------
@@ -40,6 +46,7 @@ void EnzoComputeCicInterp::pup (PUP::er &p)
   p | ia_p_;
   p | if_;
   p | dt_;
+  p | tsc_;
 }
 
 //----------------------------------------------------------------------
@@ -49,12 +56,50 @@ void EnzoComputeCicInterp::compute ( Block * block) throw()
 
   if (!block->is_leaf()) return;
 
-  compute_(block);
+  if (tsc_) {
+    const int rank = cello::rank();
+    if      (rank == 1) compute_tsc_<1>(block);
+    else if (rank == 2) compute_tsc_<2>(block);
+    else if (rank == 3) compute_tsc_<3>(block);
+  } else {
+    compute_(block);
+  }
   
 }
 
 //----------------------------------------------------------------------
 
+void EnzoComputeCicInterp::particle_cells
+(Particle particle, int it, int ib, int rank,
+ const int n3[3], const double xm3[3], const double xp3[3],
+ double dt, double * t3[3], std::vector<double> & v)
+{
+  double * t[3] = { NULL, NULL, NULL };
+  for (int axis=0; axis<rank; axis++) t[axis] = t3[axis];
+
+  particle.position_cells (it,ib,n3,xm3,xp3,t[0],t[1],t[2]);
+
+  if (dt == 0.0) return;
+
+  const int np = particle.num_particles(it,ib);
+
+  v.resize(np);
+  for (int axis=0; axis<rank; axis++) {
+    double * va[3] = { NULL, NULL, NULL };
+    va[axis] = v.data();
+    const bool has_velocity = particle.velocity (it,ib,va[0],va[1],va[2]);
+    ASSERT1 ("EnzoComputeCicInterp::particle_cells()",
+	     "Particle type %s must define velocity attributes",
+	     particle.type_name(it).c_str(),
+	     has_velocity);
+    const double s = dt * n3[axis] / (xp3[axis] - xm3[axis]);
+    double * ta = t[axis];
+    for (int ip=0; ip<np; ip++) ta[ip] += v[ip]*s;
+  }
+}
+
+//----------------------------------------------------------------------
+
 void EnzoComputeCicInterp::compute_(Block * block)
 {
   EnzoBlock * enzo_block = enzo::block(block);
@@ -64,17 +109,7 @@ void EnzoComputeCicInterp::compute_(Block * block)
 
   enzo_float * vf = (enzo_float*)field.values(if_);
 
-  const int ia_x = particle.attribute_position(it_p_,0);
-  const int ia_y = particle.attribute_position(it_p_,1);
-  const int ia_z = particle.attribute_position(it_p_,2);
-
-  const int ia_vx = particle.attribute_velocity(it_p_,0);
-  const int ia_vy = particle.attribute_velocity(it_p_,1);
-  const int ia_vz = particle.attribute_velocity(it_p_,2);
-
-  const int dp =  particle.stride(it_p_,ia_x);
   const int da =  particle.stride(it_p_,ia_p_);
-  const int dv =  particle.stride(it_p_,ia_vx);
 
   const int rank = cello::rank();
 
@@ -101,68 +136,58 @@ void EnzoComputeCicInterp::compute_(Block * block)
   block->lower(&xm,&ym,&zm);
   block->upper(&xp,&yp,&zp);
 
-  const bool lshift = (dt_ != 0.0);
+  const int    n3[3]  = { nx, ny, nz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+
+  // particle positions in cell units, advanced by dt_ (block-local
+  // integer positions are converted without reference to xm,xp)
+
+  std::vector<double> tx,ty,tz,work;
   
   const int nb = particle.num_batches(it_p_);
 
-  if (rank == 1) {
+  for (int ib=0; ib<nb; ib++) {
 
-    for (int ib=0; ib<nb; ib++) {
+    enzo_float * vp = (enzo_float*) particle.attribute_array(it_p_, ia_p_, ib);
 
-      enzo_float * vp = (enzo_float*) particle.attribute_array(it_p_, ia_p_, ib);
+    const int np = particle.num_particles(it_p_,ib);
 
-      const int np = particle.num_particles(it_p_,ib);
+    tx.resize(np);
+    ty.resize(np);
+    tz.resize(np);
+    double * t3[3] = { tx.data(), ty.data(), tz.data() };
+    particle_cells (particle,it_p_,ib,rank,n3,xm3,xp3,dt_,t3,work);
 
-      enzo_float * xa = (enzo_float *) particle.attribute_array (it_p_,ia_x,ib);
-      enzo_float * vxa = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vx,ib) : nullptr;
+    if (rank == 1) {
 
       for (int ip=0; ip<np; ip++) {
 
-	enzo_float x = lshift ? xa[ip*dp] + dt_*vxa[ip*dv] : xa[ip*dp];
-
-	enzo_float tx = nx*(x - xm) / (xp - xm) - 0.5;
+	double tx0 = tx[ip] - 0.5;
 
-	int ix0 = gx + floor(tx);
+	int ix0 = gx + floor(tx0);
 
 	int ix1 = ix0 + 1;
 
-	enzo_float x0 = 1.0 - (tx - floor(tx));
+	enzo_float x0 = 1.0 - (tx0 - floor(tx0));
 
 	enzo_float x1 = 1.0 - x0;
 
 	vp[ip*da] = x0*vf[ix0] + x1*vf[ix1];
       }
-    }
-  } else if (rank == 2) {
-
-    for (int ib=0; ib<nb; ib++) {
-
-      enzo_float * vp = (enzo_float*) particle.attribute_array(it_p_, ia_p_, ib);
-
-      const int np = particle.num_particles(it_p_,ib);
 
-      enzo_float * xa = (enzo_float *) particle.attribute_array (it_p_,ia_x,ib);
-      enzo_float * ya = (enzo_float *) particle.attribute_array (it_p_,ia_y,ib);
-
-      enzo_float * vxa = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vx,ib) : nullptr;
-      enzo_float * vya = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vy,ib) : nullptr;
+    } else if (rank == 2) {
 
       for (int ip=0; ip<np; ip++) {
 
-	enzo_float x = lshift ? xa[ip*dp] + dt_*vxa[ip*dv] : xa[ip*dp];
-	enzo_float y = lshift ? ya[ip*dp] + dt_*vya[ip*dv] : ya[ip*dp];
-
-	enzo_float tx = nx*(x - xm) / (xp - xm) - 0.5;
-	enzo_float ty = ny*(y - ym) / (yp - ym) - 0.5;
+	double tx0 = tx[ip] - 0.5;
+	double ty0 = ty[ip] - 0.5;
 
-	int ix0 = gx + floor(tx);
-	int iy0 = gy + floor(ty);
+	int ix0 = gx + floor(tx0);
+	int iy0 = gy + floor(ty0);
 
-	enzo_float x0 = 1.0 - (tx - floor(tx));
-	enzo_float y0 = 1.0 - (ty - floor(ty));
+	enzo_float x0 = 1.0 - (tx0 - floor(tx0));
+	enzo_float y0 = 1.0 - (ty0 - floor(ty0));
 
 	enzo_float x1 = 1.0 - x0;
 	enzo_float y1 = 1.0 - y0;
@@ -173,44 +198,22 @@ void EnzoComputeCicInterp::compute_(Block * block)
 	  +         x1*(y0*vf0[i100] + y1*vf0[i110]);
 
       }
-    }
-
-  } else if (rank == 3) {
 
-    for (int ib=0; ib<nb; ib++) {
+    } else if (rank == 3) {
 
-      enzo_float * vp = (enzo_float*) particle.attribute_array(it_p_, ia_p_, ib);
-
-      const int np = particle.num_particles(it_p_,ib);
-
-      enzo_float * xa = (enzo_float *) particle.attribute_array (it_p_,ia_x,ib);
-      enzo_float * ya = (enzo_float *) particle.attribute_array (it_p_,ia_y,ib);
-      enzo_float * za = (enzo_float *) particle.attribute_array (it_p_,ia_z,ib);
-
-      enzo_float * vxa = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vx,ib) : nullptr;
-      enzo_float * vya = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vy,ib) : nullptr;
-      enzo_float * vza = lshift ?
-	(enzo_float *) particle.attribute_array (it_p_,ia_vz,ib) : nullptr;
-      
       for (int ip=0; ip<np; ip++) {
 
-	enzo_float x = lshift ? xa[ip*dp] + dt_*vxa[ip*dv] : xa[ip*dp];
-	enzo_float y = lshift ? ya[ip*dp] + dt_*vya[ip*dv] : ya[ip*dp];
-	enzo_float z = lshift ? za[ip*dp] + dt_*vza[ip*dv] : za[ip*dp];
-
-	enzo_float tx = nx*(x - xm) / (xp - xm) - 0.5;
-	enzo_float ty = ny*(y - ym) / (yp - ym) - 0.5;
-	enzo_float tz = nz*(z - zm) / (zp - zm) - 0.5;
+	double tx0 = tx[ip] - 0.5;
+	double ty0 = ty[ip] - 0.5;
+	double tz0 = tz[ip] - 0.5;
 
-	int ix0 = gx + floor(tx);
-	int iy0 = gy + floor(ty);
-	int iz0 = gz + floor(tz);
+	int ix0 = gx + floor(tx0);
+	int iy0 = gy + floor(ty0);
+	int iz0 = gz + floor(tz0);
 
-	enzo_float x0 = 1.0 - (tx - floor(tx));
-	enzo_float y0 = 1.0 - (ty - floor(ty));
-	enzo_float z0 = 1.0 - (tz - floor(tz));
+	enzo_float x0 = 1.0 - (tx0 - floor(tx0));
+	enzo_float y0 = 1.0 - (ty0 - floor(ty0));
+	enzo_float z0 = 1.0 - (tz0 - floor(tz0));
 
 	enzo_float x1 = 1.0 - x0;
 	enzo_float y1 = 1.0 - y0;
@@ -227,3 +230,89 @@ void EnzoComputeCicInterp::compute_(Block * block)
   }
 }  
 
+//----------------------------------------------------------------------
+
+template <int RANK>
+void EnzoComputeCicInterp::compute_tsc_(Block * block)
+{
+  Field field = block->data()->field();
+  Particle particle = block->data()->particle();
+
+  const enzo_float * vf = (const enzo_float*)field.values(if_);
+
+  int mx,my,mz;
+  field.dimensions(0,&mx,&my,&mz);
+  int nx,ny,nz;
+  field.size(&nx,&ny,&nz);
+  int gx,gy,gz;
+  field.ghost_depth(0,&gx,&gy,&gz);
+
+  ASSERT4 ("EnzoComputeCicInterp::compute_tsc_()",
+	   "TSC requires ghost depth of at least 2, not (%d %d %d) in rank %d",
+	   gx,gy,gz,RANK,
+	   ((RANK < 1 || gx >= 2) && (RANK < 2 || gy >= 2) &&
+	    (RANK < 3 || gz >= 2)));
+
+  double xm,ym,zm;
+  double xp,yp,zp;
+  block->lower(&xm,&ym,&zm);
+  block->upper(&xp,&yp,&zp);
+
+  const int    n3[3]  = { nx, ny, nz };
+  const int    g3[3]  = { gx, gy, gz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+
+  // field index offsets for each axis
+
+  const int d3[3] = { 1, mx, mx*my };
+
+  // stencil half-widths: unused axes contribute only their central
+  // cell, with weight 1
+
+  const int kx = 1;
+  const int ky = (RANK >= 2) ? 1 : 0;
+  const int kz = (RANK >= 3) ? 1 : 0;
+
+  const int da = particle.stride(it_p_,ia_p_);
+
+  std::vector<double> t[3],work;
+
+  const int nb = particle.num_batches(it_p_);
+
+  for (int ib=0; ib<nb; ib++) {
+
+    enzo_float * vp = (enzo_float*) particle.attribute_array(it_p_, ia_p_, ib);
+
+    const int np = particle.num_particles(it_p_,ib);
+
+    double * t3[3] = { NULL, NULL, NULL };
+    for (int axis=0; axis<RANK; axis++) {
+      t[axis].resize(np);
+      t3[axis] = t[axis].data();
+    }
+    particle_cells (particle,it_p_,ib,RANK,n3,xm3,xp3,dt_,t3,work);
+
+    for (int ip=0; ip<np; ip++) {
+
+      double w[3][3] = { {0.0,1.0,0.0}, {0.0,1.0,0.0}, {0.0,1.0,0.0} };
+      int i0 = 0;
+
+      for (int axis=0; axis<RANK; axis++) {
+	i0 += d3[axis] * (g3[axis] + tsc_weights(t3[axis][ip],w[axis]));
+      }
+
+      double value = 0.0;
+      for (int jz=-kz; jz<=kz; jz++) {
+	for (int jy=-ky; jy<=ky; jy++) {
+	  const double wyz = w[2][jz+1]*w[1][jy+1];
+	  const int i = i0 + jy*d3[1] + jz*d3[2];
+	  for (int jx=-kx; jx<=kx; jx++) {
+	    value += wyz*w[0][jx+1]*vf[i+jx];
+	  }
+	}
+      }
+      vp[ip*da] = value;
+    }
+  }
+}
@@ -12,7 +12,8 @@ class EnzoComputeCicInterp : public Compute {
 
   /// @class    EnzoComputeCicInterp
   /// @ingroup  Enzo
-  /// @brief    [\ref Enzo] Encapsulate CIC (Cloud-in-cell) particle-field interpolation
+  /// @brief    [\ref Enzo] Encapsulate CIC (Cloud-in-cell) or TSC
+  /// (Triangular-shaped-cloud) particle-field interpolation
 
 public: // interface
 
@@ -20,7 +21,8 @@ public: // interface
   EnzoComputeCicInterp (std::string field_name,
 			std::string particle_type,
 			std::string particle_attribute,
-			double dt = 0.0);
+			double dt = 0.0,
+			std::string type = "cic");
 
   /// Charm++ PUP::able declarations
   PUPable_decl(EnzoComputeCicInterp);
@@ -31,7 +33,8 @@ public: // interface
       it_p_(0),
       ia_p_(0),
       if_(0),
-      dt_(0.0)
+      dt_(0.0),
+      tsc_(false)
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -40,10 +43,36 @@ public: // interface
   /// Perform the computation on the block
   virtual void compute( Block * block) throw();
 
+  /// Compute TSC weights w[0:2] for cells i-1, i, i+1 given the
+  /// particle position t in cell units (cell i spans [i,i+1)), and
+  /// return i.  Shared by TSC deposit and interpolation so that the
+  /// two are matched.
+  static int tsc_weights (double t, double w[3])
+  {
+    const double f = floor(t);
+    const double d = t - f - 0.5;
+    w[0] = 0.5*(0.5-d)*(0.5-d);
+    w[1] = 0.75 - d*d;
+    w[2] = 0.5*(0.5+d)*(0.5+d);
+    return (int) f;
+  }
+
+  /// Compute positions t3[axis][0:np) in cell units (cell i spans
+  /// [i,i+1)) of particles in batch ib advanced by v*dt, for a Block
+  /// of n3 cells spanning [xm3,xp3).  Positions may be absolute
+  /// (float) or block-local (int); v is a work array
+  static void particle_cells
+  (Particle particle, int it, int ib, int rank,
+   const int n3[3], const double xm3[3], const double xp3[3],
+   double dt, double * t3[3], std::vector<double> & v);
+
 private: // functions
 
   void compute_(Block * block);
 
+  template <int RANK>
+  void compute_tsc_(Block * block);
+
 private: // attributes
 
   /// particle type
@@ -58,6 +87,9 @@ private: // attributes
   /// dt at which to apply the interpolation
   double dt_;
 
+  /// Whether to use TSC instead of CIC
+  bool tsc_;
+
 };
 
 #endif /* ENZO_ENZO_COMPUTE_CIC_INTERP_HPP */
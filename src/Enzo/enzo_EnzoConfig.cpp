@@ -33,6 +33,7 @@ EnzoConfig::EnzoConfig() throw ()
   ppm_steepening(false),
   ppm_use_minimum_pressure_support(false),
   ppm_mol_weight(0.0),
+  ppm_native(false),
   field_gamma(0.0),
   physics_cosmology(false),
   physics_cosmology_hubble_constant_now(0.0),
@@ -97,6 +98,7 @@ EnzoConfig::EnzoConfig() throw ()
   interpolation_method(""),
   // EnzoMethodHeat
   method_heat_alpha(0.0),
+  method_heat_solver(""),
   // EnzoMethodHydro
   method_hydro_method(""),
   method_hydro_dual_energy(false),
@@ -118,8 +120,11 @@ EnzoConfig::EnzoConfig() throw ()
   method_gravity_accumulate(false),
   /// EnzoMethodPmDeposit
   method_pm_deposit_alpha(0.5),
+  method_pm_deposit_sort(false),
+  method_pm_deposit_type("cic"),
   /// EnzoMethodPmUpdate
   method_pm_update_max_dt(std::numeric_limits<double>::max()),
+  method_pm_update_type("cic"),
   /// EnzoSolverMg0
   solver_pre_smooth(),
   solver_post_smooth(),
@@ -178,6 +183,7 @@ void EnzoConfig::pup (PUP::er &p)
   p | ppm_steepening;
   p | ppm_use_minimum_pressure_support;
   p | ppm_mol_weight;
+  p | ppm_native;
 
   p | field_gamma;
 
@@ -252,6 +258,7 @@ void EnzoConfig::pup (PUP::er &p)
   p | interpolation_method;
 
   p | method_heat_alpha;
+  p | method_heat_solver;
 
   p | method_hydro_method;
   p | method_hydro_dual_energy;
@@ -271,7 +278,10 @@ void EnzoConfig::pup (PUP::er &p)
   p | method_gravity_accumulate;
 
   p | method_pm_deposit_alpha;
+  p | method_pm_deposit_sort;
+  p | method_pm_deposit_type;
   p | method_pm_update_max_dt;
+  p | method_pm_update_type;
 
   p | solver_pre_smooth;
   p | solver_post_smooth;
@@ -366,6 +376,8 @@ void EnzoConfig::read(Parameters * p) throw()
     ("Method:ppm:use_minimum_pressure_support",false);
   ppm_mol_weight = p->value_float
     ("Method:ppm:mol_weight",0.6);
+  ppm_native = p->value_logical
+    ("Method:ppm:native",false);
 
   // InitialMusic
 
@@ -406,9 +418,12 @@ void EnzoConfig::read(Parameters * p) throw()
   // PM method and initialization
 
   method_pm_deposit_alpha = p->value_float ("Method:pm_deposit:alpha",0.5);
+  method_pm_deposit_sort = p->value_logical ("Method:pm_deposit:sort",false);
+  method_pm_deposit_type = p->value_string ("Method:pm_deposit:type","cic");
 
   method_pm_update_max_dt = p->value_float 
     ("Method:pm_update:max_dt", std::numeric_limits<double>::max());
+  method_pm_update_type = p->value_string ("Method:pm_update:type","cic");
 
   
   initial_pm_field        = p->value_string  ("Initial:pm:field","density");
@@ -543,6 +558,9 @@ void EnzoConfig::read(Parameters * p) throw()
   method_heat_alpha = p->value_float 
     ("Method:heat:alpha",1.0);
 
+  method_heat_solver = p->value_string
+    ("Method:heat:solver","");
+
   method_hydro_method = p->value_string 
     ("Method:hydro:method","ppm");
 
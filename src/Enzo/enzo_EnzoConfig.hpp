@@ -55,6 +55,7 @@ public: // interface
       ppm_steepening(false),
       ppm_use_minimum_pressure_support(false),
       ppm_mol_weight(0.0),
+      ppm_native(false),
       field_gamma(0.0),
       // Cosmology
       physics_cosmology(false),
@@ -120,6 +121,7 @@ public: // interface
       interpolation_method(""),
       // EnzoMethodHeat
       method_heat_alpha(0.0),
+      method_heat_solver(""),
       // EnzoMethodHydro
       method_hydro_method(""),
       method_hydro_dual_energy(false),
@@ -141,8 +143,11 @@ public: // interface
       method_gravity_accumulate(false),
       // EnzoMethodPmDeposit
       method_pm_deposit_alpha(0.5),
+      method_pm_deposit_sort(false),
+      method_pm_deposit_type(""),
       // EnzoMethodPmUpdate
       method_pm_update_max_dt(0.0),
+      method_pm_update_type(""),
       // EnzoSolverMg0
       solver_pre_smooth(),
       solver_post_smooth(),
@@ -200,6 +205,7 @@ public: // attributes
   bool                       ppm_steepening;
   bool                       ppm_use_minimum_pressure_support;
   double                     ppm_mol_weight;
+  bool                       ppm_native;
 
   double                     field_gamma;
 
@@ -287,6 +293,7 @@ public: // attributes
 
   /// EnzoMethodHeat
   double                     method_heat_alpha;
+  std::string                method_heat_solver;
 
   /// EnzoMethodHydro
   std::string                method_hydro_method;
@@ -314,10 +321,13 @@ public: // attributes
   /// EnzoMethodPmDeposit
 
   double                     method_pm_deposit_alpha;
+  bool                       method_pm_deposit_sort;
+  std::string                method_pm_deposit_type;
 
   /// EnzoMethodPmUpdate
 
   double                     method_pm_update_max_dt;
+  std::string                method_pm_update_type;
 
   ///==============
   /// EnzoSolverMg0
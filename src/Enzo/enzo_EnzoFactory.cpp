@@ -194,7 +194,8 @@ void EnzoFactory::create_block
  int cycle, double time, double dt,
  int narray, char * array, int refresh_type,
  int num_face_level, int * face_level,
- Simulation * simulation
+ Simulation * simulation,
+ int ip_insert
  ) const throw()
 {
 #ifdef DEBUG_ENZO_FACTORY
@@ -233,6 +234,6 @@ void EnzoFactory::create_block
   msg->set_data_msg(data_msg);
 
   enzo::simulation()->set_msg_refine (index,msg);
-  enzo_block_array[index].insert ( process_type(CkMyPe()) );
+  enzo_block_array[index].insert ( process_type(CkMyPe()), ip_insert );
 }
 
@@ -62,7 +62,8 @@ public: // interface
    int nx, int ny, int nz,
    int num_field_blocks) const throw();
 
-  /// Create a new Block  [abstract factory design pattern]
+  /// Create a new Block, on process ip_insert if it is not -1
+  /// [abstract factory design pattern]
   virtual void create_block
   (
    DataMsg * data_msg,
@@ -74,7 +75,8 @@ public: // interface
    int cycle, double time, double dt,
    int narray, char * array, int refresh_type,
    int num_face_level, int * face_level,
-   Simulation * simulation = 0
+   Simulation * simulation = 0,
+   int ip_insert = -1
 ) const throw();
 
 };
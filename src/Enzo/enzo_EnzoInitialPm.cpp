@@ -11,6 +11,32 @@
 
 //----------------------------------------------------------------------
 
+namespace {
+
+  /// Store the absolute coordinate x in [xm,xp) as particle ip's
+  /// position, converting to block-local integer units [-PMAX,PMAX)
+  /// if positions are integers
+  void set_position_ (Particle & particle, int it, int ia, int ib, int ip,
+		      double x, double xm, double xp)
+  {
+    char * array = particle.attribute_array (it,ia,ib);
+    const int ps = particle.stride(it,ia);
+    const int64_t pmax = particle.position_int_max(it);
+    const int64_t a = (pmax == 0) ? 0 :
+      (int64_t) floor((2.0*(x - xm)/(xp - xm) - 1.0) * pmax);
+    switch (particle.attribute_type(it,ia)) {
+    case type_int8:  ((int8_t *) array)[ip*ps] = a; break;
+    case type_int16: ((int16_t *)array)[ip*ps] = a; break;
+    case type_int32: ((int32_t *)array)[ip*ps] = a; break;
+    case type_int64: ((int64_t *)array)[ip*ps] = a; break;
+    default:         ((enzo_float *)array)[ip*ps] = x; break;
+    }
+  }
+
+}
+
+//----------------------------------------------------------------------
+
 void EnzoInitialPm::pup (PUP::er &p)
 {
   // NOTE: update whenever attributes change
@@ -141,17 +167,11 @@ void EnzoInitialPm::uniform_placement_
   particle.insert_particles (it,np);
   enzo::simulation()->data_insert_particles(np);
   
-  const int npb = particle.batch_size();
+  const int npb = particle.batch_size(it);
 
   int ib=0;  // batch counter
   int ipb=0;  // particle / batch counter 
 
-  enzo_float * xa = 0;
-  enzo_float * ya = 0;
-  enzo_float * za = 0;
-
-  const int ps  = particle.stride(it,ia_x);
-
   for (int iz=0; iz<nz; ++iz) {
     for (int iy=0; iy<ny; ++iy) {
       for (int ix=0; ix<nx; ++ix) {
@@ -160,14 +180,15 @@ void EnzoInitialPm::uniform_placement_
 	  for (int kz = 0; kz<rz; kz++) {
 	    for (int ky = 0; ky<ry; ky++) {
 	      for (int kx = 0; kx<rx; kx++) {
-		if (ipb % npb == 0) {
-		  if (rank >= 1) xa = (enzo_float *) particle.attribute_array(it,ia_x,ib);
-		  if (rank >= 2) ya = (enzo_float *) particle.attribute_array(it,ia_y,ib);
-		  if (rank >= 3) za = (enzo_float *) particle.attribute_array(it,ia_z,ib);
-		}
-		if (rank >= 1) xa[ipb*ps] = xv[ix] - 0.5*hx + (kx+0.5)*hx/rx;
-		if (rank >= 2) ya[ipb*ps] = yv[iy] - 0.5*hy + (ky+0.5)*hy/ry;
-		if (rank >= 3) za[ipb*ps] = zv[iz] - 0.5*hz + (kz+0.5)*hz/rz;
+		if (rank >= 1) set_position_
+		  (particle,it,ia_x,ib,ipb,
+		   xv[ix] - 0.5*hx + (kx+0.5)*hx/rx, xm,xp);
+		if (rank >= 2) set_position_
+		  (particle,it,ia_y,ib,ipb,
+		   yv[iy] - 0.5*hy + (ky+0.5)*hy/ry, ym,yp);
+		if (rank >= 3) set_position_
+		  (particle,it,ia_z,ib,ipb,
+		   zv[iz] - 0.5*hz + (kz+0.5)*hz/rz, zm,zp);
 
 		ipb++;
 
@@ -278,17 +299,11 @@ void EnzoInitialPm::density_placement_
   const int ia_y = particle.attribute_index (it,"y");
   const int ia_z = particle.attribute_index (it,"z");
 
-  const int npb = particle.batch_size();
+  const int npb = particle.batch_size(it);
 
   int ib=0;  // batch counter
   int ipb=0;  // particle / batch counter 
 
-  enzo_float * xa = 0;
-  enzo_float * ya = 0;
-  enzo_float * za = 0;
-
-  const int ps  = particle.stride(it,ia_x);
-
   for (int ip=0; ip<np; ip++) {
 
     double r = rmax*rand()/RAND_MAX;
@@ -322,16 +337,9 @@ void EnzoInitialPm::density_placement_
     double y = (rank >= 2) ? ys[ims] + hy*rand()/(RAND_MAX+1.0) : 0;
     double z = (rank >= 3) ? zs[ims] + hz*rand()/(RAND_MAX+1.0) : 0;
     
-    // ... if new batch then update position arrays
-    if (ipb % npb == 0) {
-      if (rank >= 1) xa = (enzo_float *) particle.attribute_array (it,ia_x,ib);
-      if (rank >= 2) ya = (enzo_float *) particle.attribute_array (it,ia_y,ib);
-      if (rank >= 3) za = (enzo_float *) particle.attribute_array (it,ia_z,ib);
-    }
-
-    if (rank >= 1) xa[ipb*ps] = x;
-    if (rank >= 2) ya[ipb*ps] = y;
-    if (rank >= 3) za[ipb*ps] = z;
+    if (rank >= 1) set_position_ (particle,it,ia_x,ib,ipb,x,xm,xp);
+    if (rank >= 2) set_position_ (particle,it,ia_y,ib,ipb,y,ym,yp);
+    if (rank >= 3) set_position_ (particle,it,ia_z,ib,ipb,z,zm,zp);
 
     ipb++;
 
@@ -24,6 +24,7 @@ void EnzoMatrixLaplace::matvec (int i_y, int i_x, Block * block,
   enzo_float * Y = (enzo_float * ) field.values(i_y);
   
   matvec_(Y,X,g0);
+  shift_apply_(Y,X,g0);
 }
 
 //----------------------------------------------------------------------
@@ -33,6 +34,7 @@ void EnzoMatrixLaplace::matvec
  void * y, void * x, int g0) throw()
 {
   matvec_((enzo_float *)(y),(enzo_float *)(x),g0);
+  shift_apply_((enzo_float *)(y),(enzo_float *)(x),g0);
 }
 
 //----------------------------------------------------------------------
@@ -47,6 +49,7 @@ void EnzoMatrixLaplace::diagonal (int i_x, Block * block, int g0) throw()
   enzo_float * X = (enzo_float * ) field.values(i_x);
 
   diagonal_(X,g0);
+  shift_apply_(X,NULL,g0);
 }
 
 //----------------------------------------------------------------------
@@ -362,3 +365,32 @@ void EnzoMatrixLaplace::diagonal_ (enzo_float * X, int g0) const throw()
   
 }
 
+//----------------------------------------------------------------------
+
+void EnzoMatrixLaplace::shift_apply_
+(enzo_float * Y, const enzo_float * X, int g0) const throw()
+{
+  if (shift_ == 0.0 && scale_ == 1.0) return;
+
+  // X == NULL is used for the diagonal, where X is the identity
+
+  g0 = std::max(ghost_depth(),g0);
+
+  const int rank = cello::rank();
+
+  const int gx = g0;
+  const int gy = (rank >= 2) ? g0 : 0;
+  const int gz = (rank >= 3) ? g0 : 0;
+
+  const enzo_float shift = shift_;
+  const enzo_float scale = scale_;
+
+  for     (int iz=gz; iz<mz_-gz; iz++) {
+    for   (int iy=gy; iy<my_-gy; iy++) {
+      for (int ix=gx; ix<mx_-gx; ix++) {
+	const int i = ix + mx_*(iy + my_*iz);
+	Y[i] = scale*Y[i] + shift*(X ? X[i] : 1.0);
+      }
+    }
+  }
+}
@@ -27,7 +27,9 @@ public: // interface
       hx_(0.0),
       hy_(0.0),
       hz_(0.0),
-      order_(order)
+      order_(order),
+      shift_(0.0),
+      scale_(1.0)
   {}
 
   /// Destructor
@@ -49,7 +51,9 @@ public: // interface
       hx_(0.0),
       hy_(0.0),
       hz_(0.0),
-      order_(0)
+      order_(0),
+      shift_(0.0),
+      scale_(1.0)
   { }
 
     /// CHARM++ Pack / Unpack function
@@ -66,6 +70,8 @@ public: // interface
     p | hy_;
     p | hz_;
     p | order_;
+    p | shift_;
+    p | scale_;
   }
 
   /// Set cell widths.  Required for lower-level methods that don't have
@@ -76,6 +82,15 @@ public: // interface
     hy_ = hy;
     hz_ = hz;
   }
+
+  /// Use the shifted operator A = shift*I + scale*L instead of L,
+  /// e.g. shift = 1 and scale = -alpha*dt/2 for Crank-Nicolson
+  /// diffusion
+  void set_shift (double shift, double scale)
+  {
+    shift_ = shift;
+    scale_ = scale;
+  }
   
 public: // virtual functions
 
@@ -93,7 +108,7 @@ public: // virtual functions
 
   /// Whether the matrix is singular or not
   virtual bool is_singular() const throw()
-  { return true; }
+  { return (shift_ == 0.0); }
 
   /// How many ghost zones required for matvec
   virtual int ghost_depth() const throw()
@@ -105,6 +120,10 @@ protected: // functions
 
   void diagonal_ (enzo_float * X, int g0) const throw();
 
+  /// Apply the diagonal shift and scaling Y <-- shift*X + scale*Y
+  void shift_apply_ (enzo_float * Y, const enzo_float * X, int g0)
+    const throw();
+
 protected: // attributes
 
   int mx_, my_, mz_;
@@ -113,6 +132,10 @@ protected: // attributes
   /// Order of the operator, 2 or 4
   int order_;
 
+  /// Diagonal shift and scaling: A = shift_*I + scale_*L
+  double shift_;
+  double scale_;
+
 };
 
 #endif /* COMPUTE_MATRIX_LAPLACE_HPP */
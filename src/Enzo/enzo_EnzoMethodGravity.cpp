@@ -461,7 +461,7 @@ void EnzoMethodGravity::compute_accelerations (EnzoBlock * enzo_block) throw()
     int ia_az = particle.attribute_index(it,"az");
     int nx,ny,nz;
     field.size (&nx,&ny,&nz);
-    int mb = particle.batch_size();
+    int mb = particle.batch_size(it);
     char buffer[80];
     sprintf (buffer,"particles-%03d.data",enzo_block->cycle());
     CkPrintf ("file = %s\n",buffer);
@@ -9,12 +9,16 @@
 
 #include "enzo.hpp"
 
+#include "enzo.decl.h"
+
 //----------------------------------------------------------------------
 
-EnzoMethodHeat::EnzoMethodHeat (double alpha, double courant) 
+EnzoMethodHeat::EnzoMethodHeat (double alpha, double courant,
+				int index_solver)
   : Method(),
     alpha_(alpha),
-    courant_(courant)
+    courant_(courant),
+    index_solver_(index_solver)
 {
   // Initialize default Refresh object
 
@@ -39,6 +43,7 @@ void EnzoMethodHeat::pup (PUP::er &p)
 
   p | alpha_;
   p | courant_;
+  p | index_solver_;
 }
 
 //----------------------------------------------------------------------
@@ -46,6 +51,13 @@ void EnzoMethodHeat::pup (PUP::er &p)
 void EnzoMethodHeat::compute ( Block * block) throw()
 {
 
+  if (index_solver_ >= 0) {
+
+    // Solver calls compute_done() via EnzoBlock::r_method_heat_end()
+    compute_implicit_ (block);
+    return;
+  }
+
   if (block->is_leaf()) {
 
     Field field = block->data()->field();
@@ -81,6 +93,9 @@ double EnzoMethodHeat::timestep ( Block * block ) const throw()
   if (rank >= 2) h_min = std::min(h_min,hy);
   if (rank >= 3) h_min = std::min(h_min,hz);
 
+  // Crank-Nicolson is unconditionally stable, so the courant
+  // parameter may be much larger than one to control accuracy only
+
   return 0.5*courant_*h_min*h_min/alpha_;
 }
 
@@ -171,3 +186,64 @@ void EnzoMethodHeat::compute_ (Block * block,enzo_float * Unew) const throw()
   delete [] U;
 
 }
+
+//----------------------------------------------------------------------
+
+void EnzoMethodHeat::compute_implicit_ (Block * block) throw()
+{
+  // Crank-Nicolson: (I - alpha*dt/2 L) T' = (I + alpha*dt/2 L) T
+
+  Field field = block->data()->field();
+
+  const int it = field.field_id ("temperature");
+  const int ib = field.field_id ("B");
+
+  ASSERT ("EnzoMethodHeat::compute_implicit_()",
+	  "Implicit heat method requires field \"B\"",
+	  ib >= 0);
+
+  int mx,my,mz;
+  field.dimensions (it,&mx,&my,&mz);
+
+  const int m = mx*my*mz;
+
+  enzo_float * T = (enzo_float *) field.values (it);
+  enzo_float * B = (enzo_float *) field.values (ib);
+
+  const double a = 0.5*alpha_*block->dt();
+
+  const int order = 2;
+
+  if (block->is_leaf()) {
+
+    EnzoMatrixLaplace R (order);
+    R.set_shift (1.0, a);
+    R.matvec (ib, it, block);
+
+  } else {
+
+    for (int i=0; i<m; i++) B[i] = 0.0;
+
+  }
+
+  std::shared_ptr<EnzoMatrixLaplace> A
+    (std::make_shared<EnzoMatrixLaplace>(order));
+
+  A->set_shift (1.0, -a);
+
+  Solver * solver = enzo::problem()->solver(index_solver_);
+
+  solver->set_callback (CkIndex_EnzoBlock::r_method_heat_end());
+
+  solver->set_field_x (it);
+  solver->set_field_b (ib);
+
+  solver->apply (A, block);
+}
+
+//----------------------------------------------------------------------
+
+void EnzoBlock::r_method_heat_end()
+{
+  compute_done();
+}
@@ -4,7 +4,7 @@
 /// @author   James Bordner (jobordner@ucsd.edu) 
 /// @date     Thu Apr  1 16:14:38 PDT 2010
 /// @brief    [\ref Enzo] Declaration of EnzoMethodHeat
-///           forward Euler solver for the heat equation
+///           forward Euler or Crank-Nicolson solver for the heat equation
 
 #ifndef ENZO_ENZO_METHOD_HEAT_HPP
 #define ENZO_ENZO_METHOD_HEAT_HPP
@@ -15,17 +15,19 @@ class EnzoMethodHeat : public Method {
   /// @ingroup  Enzo
   ///
   /// @brief [\ref Enzo] Demonstration method to solve heat equation
-  /// using forward Euler method
+  /// using forward Euler method, or Crank-Nicolson using the given
+  /// linear solver
 
 public: // interface
 
   /// Create a new EnzoMethodHeat object
-  EnzoMethodHeat(double alpha, double courant);
+  EnzoMethodHeat(double alpha, double courant, int index_solver = -1);
 
   EnzoMethodHeat()
     : Method(),
       alpha_(0.0),
-      courant_(0.0)
+      courant_(0.0),
+      index_solver_(-1)
   { }
 
   /// Charm++ PUP::able declarations
@@ -35,7 +37,8 @@ public: // interface
   EnzoMethodHeat (CkMigrateMessage *m)
     : Method (m),
       alpha_(0.0),
-      courant_(0.0)
+      courant_(0.0),
+      index_solver_(-1)
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -54,6 +57,10 @@ protected: // methods
 
   void compute_ (Block * block, enzo_float * Unew ) const throw();
 
+  /// Set up and start the Crank-Nicolson linear solve; the solver
+  /// returns to EnzoBlock::r_method_heat_end()
+  void compute_implicit_ (Block * block) throw();
+
 protected: // attributes
 
   /// Thermal diffusivity
@@ -61,6 +68,10 @@ protected: // attributes
 
   /// Courant safety number
   double courant_;
+
+  /// Solver index for the Crank-Nicolson linear solver, or -1 for
+  /// forward Euler
+  int index_solver_;
 };
 
 #endif /* ENZO_ENZO_METHOD_HEAT_HPP */
@@ -23,6 +23,8 @@ EnzoMethodHydro::EnzoMethodHydro
   bool reconstruct_positive,
   enzo_float ppm_density_floor,
   enzo_float ppm_pressure_floor,
+  enzo_float ppm_temperature_floor,
+  enzo_float ppm_mol_weight,
   int ppm_pressure_free,
   int ppm_diffusion,
   int ppm_flattening,
@@ -42,12 +44,17 @@ EnzoMethodHydro::EnzoMethodHydro
     reconstruct_positive_(reconstruct_positive ? 1:0),
     ppm_density_floor_(ppm_density_floor),
     ppm_pressure_floor_(ppm_pressure_floor),
+    ppm_temperature_floor_(ppm_temperature_floor),
+    ppm_mol_weight_(ppm_mol_weight),
     ppm_pressure_free_(ppm_pressure_free),
     ppm_diffusion_(ppm_diffusion),
     ppm_flattening_(ppm_flattening),
     ppm_steepening_(ppm_steepening),
-    riemann_solver_(riemann_solver)
-    
+    riemann_solver_(riemann_solver),
+    index_counter_density_floor_(-1),
+    index_counter_pressure_floor_(-1),
+    index_counter_temperature_floor_(-1),
+    index_counter_dual_energy_(-1)
 {
   // Initialize default Refresh object
 
@@ -67,6 +74,43 @@ EnzoMethodHydro::EnzoMethodHydro
   refresh(ir)->add_field(field_descr->field_id("total_energy"));
   refresh(ir)->add_field(field_descr->field_id("pressure"));
 
+  initialize_counters_();
+}
+
+//----------------------------------------------------------------------
+
+void EnzoMethodHydro::initialize_counters_ ()
+{
+  // Counters are summed over processes in Simulation::monitor_performance(),
+  // so they must be created on every process, not only on those that
+  // happen to own hydro Blocks.  Counters that already exist, e.g.
+  // restored with the Performance object on restart, are reused
+
+  Simulation * simulation = cello::simulation();
+  Performance * performance = simulation ? simulation->performance() : NULL;
+
+  if (performance == NULL) return;
+
+  index_counter_density_floor_ =
+    counter_index_(performance,"hydro-density-floor");
+  index_counter_pressure_floor_ =
+    counter_index_(performance,"hydro-pressure-floor");
+  index_counter_temperature_floor_ =
+    counter_index_(performance,"hydro-temperature-floor");
+  index_counter_dual_energy_ =
+    counter_index_(performance,"hydro-dual-energy");
+}
+
+//----------------------------------------------------------------------
+
+int EnzoMethodHydro::counter_index_
+(Performance * performance, std::string name)
+{
+  const int nc = performance->num_counters();
+  for (int ic=0; ic<nc; ic++) {
+    if (performance->counter_name(ic) == name) return ic;
+  }
+  return performance->new_counter (counter_type_user,name);
 }
 
 //----------------------------------------------------------------------
@@ -91,11 +135,16 @@ void EnzoMethodHydro::pup (PUP::er &p)
   p | reconstruct_positive_;
   p | ppm_density_floor_;
   p | ppm_pressure_floor_;
+  p | ppm_temperature_floor_;
+  p | ppm_mol_weight_;
   p | ppm_pressure_free_;
   p | ppm_diffusion_;
   p | ppm_flattening_;
   p | ppm_steepening_;
   p | riemann_solver_;
+
+  // index_counter_*_ are per-process Performance registrations, so
+  // they are not packed; they are looked up again in ppm_update_x_()
 }
 
 //----------------------------------------------------------------------
@@ -1066,6 +1115,8 @@ void EnzoMethodHydro::ppm_euler_x_(Block * block, int iz)
 
   // Compute Eulerian fluxes and update zone-centered quantities
 
+  int num_density_floor = 0;
+
   FORTRAN_NAME(woc_euler)
     (dslice, eslice, grslice, geslice, uslice, vslice, wslice,
      &hxa, diffcoef, 
@@ -1074,16 +1125,13 @@ void EnzoMethodHydro::ppm_euler_x_(Block * block, int iz)
      &ppm_diffusion_, &gravity_, &dual_energy_, 
      &dual_energy_eta1_, &dual_energy_eta2_,
      df, ef, uf, vf, wf, gef, ges,
-     &nc, colslice, colf, &ppm_density_floor_);
+     &nc, colslice, colf, &ppm_density_floor_, &num_density_floor);
 
-  // /* If necessary, recompute the pressure to correctly set ge and e */
+  // Recompute the pressure to correctly set ge and e, apply floors, and
+  // copy the slice back to the Block fields in a single pass
 
-  // if (dual_energy_)
-  //   FORTRAN_NAME(woc_pgas2d_dual)(dslice, eslice, geslice, pslice, uslice, vslice, 
-  // 			      wslice, &dual_energy_eta1_, 
-  // 			      &dual_energy_eta2_, &mx, 
-  // 			      &my, &is_m3, &ie_p3, &js, &je, 
-  // 			      &gamma_, &ppm_pressure_floor_);
+  ppm_update_x_ (block, iz, dslice, eslice, geslice, pslice,
+		 uslice, vslice, wslice, colslice, nc, num_density_floor);
 
   // /* Check this slice against the list of subgrids (all subgrid
   //    quantities are zero-based) */
@@ -1157,50 +1205,153 @@ void EnzoMethodHydro::ppm_euler_x_(Block * block, int iz)
 
   // } // ENDFOR n
 
-  // /* Copy from slice to field */
+  // deallocate array
+  delete [] flatten_array;
+  delete [] fluxes_array;
+  delete [] slice_array;
+}
 
-  // for (j = 0; j < my; j++) {
+//----------------------------------------------------------------------
 
-  //   index2 = j * mx;
+void EnzoMethodHydro::ppm_update_x_
+(Block * block, int iz,
+ enzo_float * dslice, enzo_float * eslice, enzo_float * geslice,
+ enzo_float * pslice, enzo_float * uslice, enzo_float * vslice,
+ enzo_float * wslice, enzo_float * colslice, int nc,
+ int num_density_floor)
+{
+  // Fuses the post-update woc_pgas2d_dual call, the pressure and
+  // temperature floors, and the copy from slice to field, so that
+  // each cell is visited once per sweep
 
-  //   for (i = 0; i < mx; i++) {
-  //     index3 = (k*my + j)*mx + i;
-  //     de[index3] = dslice[index2+i];
-  //     et[index3] = eslice[index2+i];
-  //     vx[index3] = uslice[index2+i];
-  //   } // ENDFOR i
+  Field field = block->data()->field();
 
-  //   if (GridRank > 1)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vy[index3] = vslice[index2+i];
-  //     }
+  int mx,my,mz;
+  field.dimensions (0,&mx,&my,&mz);
 
-  //   if (GridRank > 2)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	vz[index3] = wslice[index2+i];
-  //     }
+  const int rank = cello::rank();
 
-  //   if (dual_energy_)
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j)*mx + i;
-  // 	ei[index3] = geslice[index2+i];
-  //     }
+  enzo_float * de = (enzo_float *) field.values("density");
+  enzo_float * te = (enzo_float *) field.values("total_energy");
+  enzo_float * vx = (enzo_float *) field.values("velocity_x");
+  enzo_float * vy = (enzo_float *) field.values("velocity_y");
+  enzo_float * vz = (enzo_float *) field.values("velocity_z");
+  enzo_float * pr = (enzo_float *) field.values("pressure");
+  enzo_float * ei = dual_energy_ ?
+    (enzo_float *) field.values("internal_energy") : NULL;
 
-  //   for (n = 0; n < nc; n++) {
-  //     index2 = (n*my + j) * mx;
-  //     for (i = 0; i < mx; i++) {
-  // 	index3 = (k*my + j) * mx + i;
-  // 	BaryonField[colnum[n]][index3] = colslice[index2+i];
-  //     }
-  //   } // ENDFOR colours
-  // } // ENDFOR j
+  const enzo_float gm1 = gamma_ - 1.0;
 
-  // deallocate array
-  delete [] flatten_array;
-  delete [] fluxes_array;
-  delete [] slice_array;
+  // Minimum specific internal energy implied by the temperature floor,
+  // using the same code-unit conversion as EnzoComputeTemperature
+
+  const enzo_float ge_temperature_floor =
+    (ppm_temperature_floor_ > 0.0 && ppm_mol_weight_ > 0.0) ?
+    ppm_temperature_floor_ / (ppm_mol_weight_ * gm1) : 0.0;
+
+  long long num_pressure_floor = 0;
+  long long num_temperature_floor = 0;
+  long long num_dual_energy = 0;
+
+  for (int iy=0; iy<my; iy++) {
+
+    // eslice[is] is updated below before cell is+1 is visited, so the
+    // left neighbor's total energy from before the pass is kept in
+    // e_left; the eta2 test then reads only pre-pass energies
+
+    enzo_float e_left = eslice[mx*iy];
+
+    for (int ix=0; ix<mx; ix++) {
+
+      const int i  = ix + mx*(iy + my*iz);
+      const int is = ix + mx*iy;
+
+      const enzo_float e_center = eslice[is];
+
+      const enzo_float d = dslice[is];
+      const enzo_float ke = 0.5*(uslice[is]*uslice[is] +
+				 vslice[is]*vslice[is] +
+				 wslice[is]*wslice[is]);
+      const enzo_float ge1 = eslice[is] - ke;
+
+      enzo_float ge2 = ge1;
+
+      if (dual_energy_) {
+
+	// eta2: resynchronize internal energy with total energy where
+	// the flow is not dominated locally by kinetic energy
+
+	const int ism = (ix > 0)    ? is - 1 : is;
+	const int isp = (ix < mx-1) ? is + 1 : is;
+	const enzo_float demax = std::max
+	  (dslice[is]*e_center,
+	   std::max(dslice[ism]*e_left,dslice[isp]*eslice[isp]));
+
+	if (ge1*d > dual_energy_eta2_*demax) geslice[is] = ge1;
+
+	// eta1: select pressure source
+
+	if (ge1 <= dual_energy_eta1_*eslice[is]) {
+	  ge2 = geslice[is];
+	  ++num_dual_energy;
+	}
+      }
+
+      const enzo_float ge_pressure_floor = ppm_pressure_floor_ / (gm1*d);
+
+      if (ge2 < ge_pressure_floor) {
+	ge2 = ge_pressure_floor;
+	++num_pressure_floor;
+      }
+      if (ge2 < ge_temperature_floor) {
+	ge2 = ge_temperature_floor;
+	++num_temperature_floor;
+      }
+
+      eslice[is] = eslice[is] - ge1 + ge2;
+      pslice[is] = gm1*d*ge2;
+      if (dual_energy_) geslice[is] = std::max(geslice[is],ge2);
+
+      de[i] = d;
+      te[i] = eslice[is];
+      pr[i] = pslice[is];
+      vx[i] = uslice[is];
+      if (rank >= 2) vy[i] = vslice[is];
+      if (rank >= 3) vz[i] = wslice[is];
+      if (dual_energy_) ei[i] = geslice[is];
+
+      e_left = e_center;
+    }
+  }
+
+  Grouping * field_groups = field.groups();
+
+  for (int ic=0; ic<nc; ic++) {
+    enzo_float * c = (enzo_float *)
+      field.values(field_groups->item("colour",ic));
+    for (int iy=0; iy<my; iy++) {
+      for (int ix=0; ix<mx; ix++) {
+	int i = ix + mx*(iy + my*iz);
+	int k = ix + mx*(iy + my*ic);
+	c[i] = colslice[k];
+      }
+    }
+  }
+
+  if (index_counter_density_floor_ < 0) initialize_counters_();
+
+  Performance * performance = cello::simulation()->performance();
+
+  if (index_counter_density_floor_ >= 0) {
+    performance->increment_counter
+      (index_counter_density_floor_,num_density_floor);
+    performance->increment_counter
+      (index_counter_pressure_floor_,num_pressure_floor);
+    performance->increment_counter
+      (index_counter_temperature_floor_,num_temperature_floor);
+    performance->increment_counter
+      (index_counter_dual_energy_,num_dual_energy);
+  }
 }
 
 //----------------------------------------------------------------------
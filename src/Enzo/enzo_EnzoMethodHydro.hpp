@@ -109,7 +109,8 @@ extern "C" void FORTRAN_NAME(woc_euler)
    int *gravity, int *idual, enzo_float *eta1, enzo_float *eta2, enzo_float *df, 
    enzo_float *ef, enzo_float *uf, enzo_float *vf, enzo_float *wf, enzo_float *gef,
    enzo_float *ges,
-   int *ncolor, enzo_float *colslice, enzo_float *colf, enzo_float *dfloor);
+   int *ncolor, enzo_float *colslice, enzo_float *colf, enzo_float *dfloor,
+   int *nfloor);
 
 
 class EnzoMethodHydro : public Method {
@@ -133,6 +134,8 @@ public: // interface
 		  bool reconstruct_positive,
 		  enzo_float ppm_density_floor,
 		  enzo_float ppm_pressure_floor,
+		  enzo_float ppm_temperature_floor,
+		  enzo_float ppm_mol_weight,
 		  int ppm_pressure_free,
 		  int ppm_diffusion,
 		  int ppm_flattening,
@@ -157,11 +160,17 @@ public: // interface
       reconstruct_positive_(0),
       ppm_density_floor_(0.0),
       ppm_pressure_floor_(0.0),
+      ppm_temperature_floor_(0.0),
+      ppm_mol_weight_(0.0),
       ppm_pressure_free_(0),
       ppm_diffusion_(0),
       ppm_flattening_(0),
       ppm_steepening_(0),
-      riemann_solver_("")
+      riemann_solver_(""),
+      index_counter_density_floor_(-1),
+      index_counter_pressure_floor_(-1),
+      index_counter_temperature_floor_(-1),
+      index_counter_dual_energy_(-1)
   {}
 
   /// CHARM++ Pack / Unpack function
@@ -184,6 +193,24 @@ protected: // methods
   void ppm_euler_x_ (Block * block, int iz);
   void ppm_euler_y_ (Block * block, int ix);
   void ppm_euler_z_ (Block * block, int iy);
+
+  /// Copy an updated x-slice back to the Block fields, applying the
+  /// pressure and temperature floors and the dual-energy eta1 / eta2
+  /// selection in the same pass.  The density floor is applied by
+  /// woc_euler, which returns the number of clamped cells in
+  /// num_density_floor
+  void ppm_update_x_ (Block * block, int iz,
+		      enzo_float * dslice, enzo_float * eslice,
+		      enzo_float * geslice, enzo_float * pslice,
+		      enzo_float * uslice, enzo_float * vslice,
+		      enzo_float * wslice, enzo_float * colslice, int nc,
+		      int num_density_floor);
+
+  /// Create (or find existing) Performance counters for floor hits
+  void initialize_counters_ ();
+
+  /// Return the index of the named user counter, creating it if needed
+  static int counter_index_ (Performance * performance, std::string name);
   
 protected: // attributes
 
@@ -221,6 +248,12 @@ protected: // attributes
   /// minimum pressure
   enzo_float ppm_pressure_floor_;
 
+  /// minimum temperature
+  enzo_float ppm_temperature_floor_;
+
+  /// molecular weight used to convert the temperature floor
+  enzo_float ppm_mol_weight_;
+
   /// Whether to assume pressure-free
   int ppm_pressure_free_;
 
@@ -236,6 +269,14 @@ protected: // attributes
   /// Riemann solver to use
   std::string riemann_solver_;
 
+  /// Performance counter indices for cells hitting each floor
+  int index_counter_density_floor_;
+  int index_counter_pressure_floor_;
+  int index_counter_temperature_floor_;
+
+  /// Performance counter index for cells using the internal energy field
+  int index_counter_dual_energy_;
+
 };
   
 #endif /* ENZO_ENZO_METHOD_HYDRO_HPP */
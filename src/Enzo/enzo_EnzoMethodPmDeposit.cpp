@@ -13,6 +13,8 @@
 #include "cello.hpp"
 #include "enzo.hpp"
 
+#include <algorithm>
+
 #define FORTRAN_NAME(NAME) NAME##_
 
 extern "C" void  FORTRAN_NAME(dep_grid_cic)
@@ -27,12 +29,54 @@ extern "C" void  FORTRAN_NAME(dep_grid_cic)
    int * nx,int * ny,int * nz,
    int * ,int * ,int * );
 
+namespace {
+
+  /// Sort (key,index) pairs that are nearly in order.  Insertion sort
+  /// is tried first, since EnzoMethodPmUpdate orders particles by
+  /// their undrifted cell and drifting moves few keys far; it falls
+  /// back to std::sort once max_moves element moves are exceeded.
+  void sort_nearly_ordered_
+  (std::vector< std::pair<int64_t,int> > & order, long long max_moves)
+  {
+    const int n = order.size();
+    long long moves = 0;
+    for (int i=1; i<n; i++) {
+      const std::pair<int64_t,int> item = order[i];
+      int j = i;
+      for (; j>0 && item < order[j-1]; j--) {
+	order[j] = order[j-1];
+      }
+      order[j] = item;
+      moves += (i - j);
+      if (moves > max_moves) {
+	std::sort (order.begin(),order.end());
+	return;
+      }
+    }
+  }
+
+}
+
 //----------------------------------------------------------------------
 
-EnzoMethodPmDeposit::EnzoMethodPmDeposit ( double alpha)
+EnzoMethodPmDeposit::EnzoMethodPmDeposit
+( double alpha, bool sort, std::string type)
   : Method(),
-    alpha_(alpha)
+    alpha_(alpha),
+    sort_(sort),
+    type_(type)
 {
+  ASSERT1 ("EnzoMethodPmDeposit::EnzoMethodPmDeposit()",
+	   "Unknown deposit type \"%s\": must be \"cic\" or \"tsc\"",
+	   type.c_str(),
+	   (type == "cic" || type == "tsc"));
+
+  // The sorted, tiled deposit is CIC only
+
+  ASSERT ("EnzoMethodPmDeposit::EnzoMethodPmDeposit()",
+	  "Method:pm_deposit:sort is not supported with type \"tsc\"",
+	  ! (sort && type == "tsc"));
+
   // Initialize default Refresh object
 
   const int ir = add_refresh(4,cello::rank()-1,neighbor_leaf,sync_neighbor,
@@ -56,6 +100,8 @@ void EnzoMethodPmDeposit::pup (PUP::er &p)
   Method::pup(p);
 
   p | alpha_;
+  p | sort_;
+  p | type_;
 }
 
 //----------------------------------------------------------------------
@@ -106,7 +152,7 @@ void EnzoMethodPmDeposit::compute ( Block * block) throw()
     for (int i=0; i<mx*my*mz; i++) de_p[i] = 0.0;
     for (int i=0; i<mx*my*mz; i++) de_pa[i] = 0.0;
 
-    // check precisions match
+    // check precisions match (unless positions are block-local integers)
     
     int ia = particle.attribute_index(it,"x");
     int ba = particle.attribute_bytes(it,ia); // "bytes (actual)"
@@ -118,7 +164,7 @@ void EnzoMethodPmDeposit::compute ( Block * block) throw()
 	     particle.attribute_name(it,ia).c_str(),
 	     ((ba == 4) ? "single" : ((ba == 8) ? "double" : "quadruple")),
 	     ((be == 4) ? "single" : ((be == 8) ? "double" : "quadruple")),
-	     (ba == be));
+	     (particle.position_int_max(it) != 0 || ba == be));
 
     // Accumulate particle density using CIC
 
@@ -145,28 +191,48 @@ void EnzoMethodPmDeposit::compute ( Block * block) throw()
 
     dens *= std::pow(2.0,rank*level);
 
-    // Accumulated single velocity array for Baryon deposit
+    const bool tsc = (type_ == "tsc");
 
-    for (int ib=0; ib<particle.num_batches(it); ib++) {
+    if (tsc) {
+      if      (rank == 1) deposit_tsc_<1> (block,de_p,dens,dt);
+      else if (rank == 2) deposit_tsc_<2> (block,de_p,dens,dt);
+      else if (rank == 3) deposit_tsc_<3> (block,de_p,dens,dt);
+    } else if (sort_) {
+      if      (rank == 1) deposit_sorted_<1> (block,de_p,dens,dt);
+      else if (rank == 2) deposit_sorted_<2> (block,de_p,dens,dt);
+      else if (rank == 3) deposit_sorted_<3> (block,de_p,dens,dt);
+    }
 
-      const int np = particle.num_particles(it,ib);
+    // Batch-order CIC deposit (skipped if already deposited above)
 
-      if (rank == 1) {
+    const int nb = (tsc || sort_) ? 0 : particle.num_batches(it);
 
-	const int ia_x  = particle.attribute_index(it,"x");
-	const int ia_vx = particle.attribute_index(it,"vx");
+    const int    n3[3]  = { nx, ny, nz };
+    const double xm3[3] = { xm, ym, zm };
+    const double xp3[3] = { xp, yp, zp };
 
-	enzo_float * xa =  (enzo_float *)particle.attribute_array (it,ia_x,ib);
-	enzo_float * vxa = (enzo_float *)particle.attribute_array (it,ia_vx,ib);
+    // particle positions in cell units, advanced by dt (block-local
+    // integer positions are converted without reference to xm,xp)
 
-	const int dp =  particle.stride(it,ia_x);
-	const int dv =  particle.stride(it,ia_vx);
+    std::vector<double> t[3],work;
 
-	for (int ip=0; ip<np; ip++) {
+    for (int ib=0; ib<nb; ib++) {
 
-	  double x = xa[ip*dp] + vxa[ip*dv]*dt;
+      const int np = particle.num_particles(it,ib);
 
-	  double tx = nx*(x - xm) / (xp - xm) - 0.5;
+      double * t3[3] = { NULL, NULL, NULL };
+      for (int axis=0; axis<rank; axis++) {
+	t[axis].resize(np);
+	t3[axis] = t[axis].data();
+      }
+      EnzoComputeCicInterp::particle_cells
+	(particle,it,ib,rank,n3,xm3,xp3,dt,t3,work);
+
+      if (rank == 1) {
+
+	for (int ip=0; ip<np; ip++) {
+
+	  double tx = t3[0][ip] - 0.5;
 
 	  int ix0 = gx + floor(tx);
 
@@ -182,27 +248,10 @@ void EnzoMethodPmDeposit::compute ( Block * block) throw()
 
       } else if (rank == 2) {
 
-	const int ia_x  = particle.attribute_index(it,"x");
-	const int ia_y  = particle.attribute_index(it,"y");
-	const int ia_vx = particle.attribute_index(it,"vx");
-	const int ia_vy = particle.attribute_index(it,"vy");
-
-	// Batch arrays
-	enzo_float * xa  = (enzo_float *)particle.attribute_array (it,ia_x,ib);
-	enzo_float * ya  = (enzo_float *)particle.attribute_array (it,ia_y,ib);
-	enzo_float * vxa = (enzo_float *)particle.attribute_array (it,ia_vx,ib);
-	enzo_float * vya = (enzo_float *)particle.attribute_array (it,ia_vy,ib);
-
-	const int dp =  particle.stride(it,ia_x);
-	const int dv =  particle.stride(it,ia_vx);
-
 	for (int ip=0; ip<np; ip++) {
 
-	  double x = xa[ip*dp] + vxa[ip*dv]*dt;
-	  double y = ya[ip*dp] + vya[ip*dv]*dt;
-
-	  double tx = nx*(x - xm) / (xp - xm) - 0.5;
-	  double ty = ny*(y - ym) / (yp - ym) - 0.5;
+	  double tx = t3[0][ip] - 0.5;
+	  double ty = t3[1][ip] - 0.5;
 
 	  int ix0 = gx + floor(tx);
 	  int iy0 = gy + floor(ty);
@@ -245,36 +294,11 @@ void EnzoMethodPmDeposit::compute ( Block * block) throw()
 
       } else if (rank == 3) {
 
-	const int ia_x  = particle.attribute_index(it,"x");
-	const int ia_y  = particle.attribute_index(it,"y");
-	const int ia_z  = particle.attribute_index(it,"z");
-	const int ia_vx = particle.attribute_index(it,"vx");
-	const int ia_vy = particle.attribute_index(it,"vy");
-	const int ia_vz = particle.attribute_index(it,"vz");
-
-	enzo_float * xa  = (enzo_float *) particle.attribute_array (it,ia_x,ib);
-	enzo_float * ya  = (enzo_float *) particle.attribute_array (it,ia_y,ib);
-	enzo_float * za  = (enzo_float *) particle.attribute_array (it,ia_z,ib);
-
-	// Particle batch velocities
-	enzo_float * vxa = (enzo_float *) particle.attribute_array (it,ia_vx,ib);
-	enzo_float * vya = (enzo_float *) particle.attribute_array (it,ia_vy,ib);
-	enzo_float * vza = (enzo_float *) particle.attribute_array (it,ia_vz,ib);
-
-	const int dp =  particle.stride(it,ia_x);
-	const int dv =  particle.stride(it,ia_vx);
-
 	for (int ip=0; ip<np; ip++) {
 
-	  // Copy batch particle velocities to temporary block field velocities
-	  
-	  double x = xa[ip*dp] + vxa[ip*dv]*dt;
-	  double y = ya[ip*dp] + vya[ip*dv]*dt;
-	  double z = za[ip*dp] + vza[ip*dv]*dt;
-
-	  double tx = nx*(x - xm) / (xp - xm) - 0.5;
-	  double ty = ny*(y - ym) / (yp - ym) - 0.5;
-	  double tz = nz*(z - zm) / (zp - zm) - 0.5;
+	  double tx = t3[0][ip] - 0.5;
+	  double ty = t3[1][ip] - 0.5;
+	  double tz = t3[2][ip] - 0.5;
 
 	  int ix0 = gx + floor(tx);
 	  int iy0 = gy + floor(ty);
@@ -395,3 +419,244 @@ double EnzoMethodPmDeposit::timestep ( Block * block ) const throw()
 
   return dt;
 }
+
+//======================================================================
+
+template <int RANK>
+void EnzoMethodPmDeposit::deposit_sorted_
+(Block * block, enzo_float * de_p, double dens, double dt) throw()
+{
+  Particle particle (block->data()->particle());
+  Field    field    (block->data()->field());
+
+  int mx,my,mz;
+  field.dimensions(0,&mx,&my,&mz);
+  int nx,ny,nz;
+  field.size(&nx,&ny,&nz);
+  int gx,gy,gz;
+  field.ghost_depth(0,&gx,&gy,&gz);
+
+  double xm,ym,zm;
+  double xp,yp,zp;
+  block->lower(&xm,&ym,&zm);
+  block->upper(&xp,&yp,&zp);
+
+  // Tiles are TILE^RANK cells; Morton keys of cells sort tile-major
+  // since a tile's cells share the high-order key bits.  Keys match
+  // those used to sort particles in EnzoMethodPmUpdate, but of the
+  // position drifted by dt
+
+  const int TILE_BITS = 3;
+  const int TILE = 1 << TILE_BITS;
+  const int NA = TILE + 1;
+
+  const int    n3[3]  = { nx, ny, nz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+  const double shift[3] = { gx - 0.5, gy - 0.5, gz - 0.5 };
+
+  const int it = particle.type_index ("dark");
+
+  const int nb = particle.num_batches(it);
+  const int np = particle.num_particles(it);
+
+  // Compute particle positions in cell units (SoA, unit stride)
+
+  std::vector<double> t (RANK*np);
+  std::vector<double> work;
+
+  int ip0 = 0;
+  for (int ib=0; ib<nb; ib++) {
+    const int npb = particle.num_particles(it,ib);
+    double * t3[3] = { NULL, NULL, NULL };
+    for (int axis=0; axis<RANK; axis++) t3[axis] = &t[axis*np + ip0];
+    EnzoComputeCicInterp::particle_cells
+      (particle,it,ib,RANK,n3,xm3,xp3,dt,t3,work);
+    for (int axis=0; axis<RANK; axis++) {
+      double * ta = t3[axis];
+      const double o = shift[axis];
+      for (int ip=0; ip<npb; ip++) ta[ip] += o;
+    }
+    ip0 += npb;
+  }
+
+  // Sort particles by Morton key of their lower-left cell
+
+  std::vector< std::pair<int64_t,int> > order (np);
+
+  for (int ip=0; ip<np; ip++) {
+    const int ix = (int) floor(t[ip]);
+    const int iy = (RANK >= 2) ? (int) floor(t[np+ip])   : 0;
+    const int iz = (RANK >= 3) ? (int) floor(t[2*np+ip]) : 0;
+    order[ip] = std::make_pair (cello::morton_key(ix,iy,iz), ip);
+  }
+
+  // Particles sorted by EnzoMethodPmUpdate are keyed on their
+  // undrifted position, so the drifted keys here are nearly in order
+
+  sort_nearly_ordered_ (order, 4LL*np);
+
+  // Deposit tile by tile into a private accumulator, then flush
+
+  const int ma[3] = { NA, (RANK >= 2) ? NA : 1, (RANK >= 3) ? NA : 1 };
+  std::vector<double> acc (ma[0]*ma[1]*ma[2]);
+
+  int k = 0;
+  while (k < np) {
+
+    const int64_t tile = order[k].first >> (3*TILE_BITS);
+
+    // Tile origin from the first particle in the tile
+
+    const int ipf = order[k].second;
+    const int ox = ((int) floor(t[ipf])) & ~(TILE-1);
+    const int oy = (RANK >= 2) ? (((int) floor(t[np+ipf]))   & ~(TILE-1)) : 0;
+    const int oz = (RANK >= 3) ? (((int) floor(t[2*np+ipf])) & ~(TILE-1)) : 0;
+
+    std::fill (acc.begin(),acc.end(),0.0);
+
+    for (; k<np && (order[k].first >> (3*TILE_BITS)) == tile; k++) {
+
+      const int ip = order[k].second;
+
+      const double tx = t[ip];
+      const double fx = floor(tx);
+      const int    ix = (int)fx - ox;
+      const double x1 = tx - fx;
+      const double x0 = 1.0 - x1;
+
+      if (RANK == 1) {
+	acc[ix]   += dens*x0;
+	acc[ix+1] += dens*x1;
+	continue;
+      }
+
+      const double ty = t[np+ip];
+      const double fy = floor(ty);
+      const int    iy = (int)fy - oy;
+      const double y1 = ty - fy;
+      const double y0 = 1.0 - y1;
+
+      if (RANK == 2) {
+	const int i = ix + NA*iy;
+	acc[i]      += dens*x0*y0;
+	acc[i+1]    += dens*x1*y0;
+	acc[i+NA]   += dens*x0*y1;
+	acc[i+NA+1] += dens*x1*y1;
+	continue;
+      }
+
+      const double tz = t[2*np+ip];
+      const double fz = floor(tz);
+      const int    iz = (int)fz - oz;
+      const double z1 = tz - fz;
+      const double z0 = 1.0 - z1;
+
+      const int i = ix + NA*(iy + NA*iz);
+      const int dy = NA;
+      const int dz = NA*NA;
+      acc[i]         += dens*x0*y0*z0;
+      acc[i+1]       += dens*x1*y0*z0;
+      acc[i+dy]      += dens*x0*y1*z0;
+      acc[i+dy+1]    += dens*x1*y1*z0;
+      acc[i+dz]      += dens*x0*y0*z1;
+      acc[i+dz+1]    += dens*x1*y0*z1;
+      acc[i+dz+dy]   += dens*x0*y1*z1;
+      acc[i+dz+dy+1] += dens*x1*y1*z1;
+    }
+
+    // Flush the accumulator, clipping to the Block array
+
+    for (int jz=0; jz<ma[2]; jz++) {
+      const int kz = oz + jz;
+      if (kz < 0 || kz >= mz) continue;
+      for (int jy=0; jy<ma[1]; jy++) {
+	const int ky = oy + jy;
+	if (ky < 0 || ky >= my) continue;
+	for (int jx=0; jx<ma[0]; jx++) {
+	  const int kx = ox + jx;
+	  if (kx < 0 || kx >= mx) continue;
+	  de_p[kx + mx*(ky + my*kz)] += acc[jx + ma[0]*(jy + ma[1]*jz)];
+	}
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+
+template <int RANK>
+void EnzoMethodPmDeposit::deposit_tsc_
+(Block * block, enzo_float * de_p, double dens, double dt) throw()
+{
+  Particle particle (block->data()->particle());
+  Field    field    (block->data()->field());
+
+  int mx,my,mz;
+  field.dimensions(0,&mx,&my,&mz);
+  int nx,ny,nz;
+  field.size(&nx,&ny,&nz);
+  int gx,gy,gz;
+  field.ghost_depth(0,&gx,&gy,&gz);
+
+  ASSERT4 ("EnzoMethodPmDeposit::deposit_tsc_()",
+	   "TSC requires ghost depth of at least 2, not (%d %d %d) in rank %d",
+	   gx,gy,gz,RANK,
+	   ((RANK < 1 || gx >= 2) && (RANK < 2 || gy >= 2) &&
+	    (RANK < 3 || gz >= 2)));
+
+  double xm,ym,zm;
+  double xp,yp,zp;
+  block->lower(&xm,&ym,&zm);
+  block->upper(&xp,&yp,&zp);
+
+  const int    n3[3]  = { nx, ny, nz };
+  const int    g3[3]  = { gx, gy, gz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+  const int    d3[3]  = { 1, mx, mx*my };
+
+  const int kx = 1;
+  const int ky = (RANK >= 2) ? 1 : 0;
+  const int kz = (RANK >= 3) ? 1 : 0;
+
+  const int it = particle.type_index ("dark");
+
+  std::vector<double> t[3],work;
+
+  const int nb = particle.num_batches(it);
+
+  for (int ib=0; ib<nb; ib++) {
+
+    const int np = particle.num_particles(it,ib);
+
+    double * t3[3] = { NULL, NULL, NULL };
+    for (int axis=0; axis<RANK; axis++) {
+      t[axis].resize(np);
+      t3[axis] = t[axis].data();
+    }
+    EnzoComputeCicInterp::particle_cells
+      (particle,it,ib,RANK,n3,xm3,xp3,dt,t3,work);
+
+    for (int ip=0; ip<np; ip++) {
+
+      double w[3][3] = { {0.0,1.0,0.0}, {0.0,1.0,0.0}, {0.0,1.0,0.0} };
+      int i0 = 0;
+
+      for (int axis=0; axis<RANK; axis++) {
+	i0 += d3[axis] * (g3[axis] + EnzoComputeCicInterp::tsc_weights
+			  (t3[axis][ip],w[axis]));
+      }
+
+      for (int jz=-kz; jz<=kz; jz++) {
+	for (int jy=-ky; jy<=ky; jy++) {
+	  const double dyz = dens*w[2][jz+1]*w[1][jy+1];
+	  const int i = i0 + jy*d3[1] + jz*d3[2];
+	  for (int jx=-kx; jx<=kx; jx++) {
+	    de_p[i+jx] += dyz*w[0][jx+1];
+	  }
+	}
+      }
+    }
+  }
+}
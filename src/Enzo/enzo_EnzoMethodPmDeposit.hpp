@@ -17,7 +17,8 @@ class EnzoMethodPmDeposit : public Method {
 public: // interface
 
   /// Create a new EnzoMethodPmDeposit object
-  EnzoMethodPmDeposit(double alpha = 0.5);
+  EnzoMethodPmDeposit(double alpha = 0.5, bool sort = false,
+		      std::string type = "cic");
 
   /// Charm++ PUP::able declarations
   PUPable_decl(EnzoMethodPmDeposit);
@@ -25,7 +26,9 @@ public: // interface
   /// Charm++ PUP::able migration constructor
   EnzoMethodPmDeposit (CkMigrateMessage *m)
     : Method (m),
-      alpha_(0.0)
+      alpha_(0.0),
+      sort_(false),
+      type_("cic")
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -40,11 +43,31 @@ public: // interface
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
+protected: // methods
+
+  /// Deposit particle mass using CIC with particles visited in Morton
+  /// order of their cells, accumulating into per-tile private arrays
+  template <int RANK>
+  void deposit_sorted_ (Block * block, enzo_float * de_p,
+			double dens, double dt) throw();
+
+  /// Deposit particle mass using TSC, matching the weights used by
+  /// EnzoComputeCicInterp
+  template <int RANK>
+  void deposit_tsc_ (Block * block, enzo_float * de_p,
+		     double dens, double dt) throw();
+
 protected: // attributes
 
   /// Deposit at time + alpha*dt
   double alpha_;
 
+  /// Whether to use the cell-sorted tiled deposit (CIC only)
+  bool sort_;
+
+  /// Particle deposit type, "cic" or "tsc"
+  std::string type_;
+
 };
 
 #endif /* ENZO_ENZO_METHOD_PM_DEPOSIT_HPP */
@@ -9,6 +9,10 @@
 #include "charm_simulation.hpp"
 #include "enzo.hpp"
 
+#ifdef CONFIG_USE_CKLOOP
+#  include "CkLoopAPI.h"
+#endif
+
 // #define DEBUG_UPDATE
 
 #ifdef DEBUG_UPDATE
@@ -21,10 +25,146 @@
 
 //----------------------------------------------------------------------
 
+namespace {
+
+  /// Kick-drift-kick one axis of a particle batch, and update the
+  /// velocity and acceleration timestep bounds.  STRIDE is the
+  /// compile-time attribute stride, or 0 to use the run-time strides
+  template <int STRIDE>
+  void update_axis_
+  (enzo_float * __restrict__ x,
+   enzo_float * __restrict__ v,
+   const enzo_float * __restrict__ a,
+   int np, int dp, int dv, int da,
+   double cp, double cvv, double cva, double h,
+   double & dt_v, double & dt_a)
+  {
+    if (STRIDE) dp = dv = da = STRIDE;
+    double dt_v_min = dt_v;
+    double dt_a_min = dt_a;
+    for (int ip=0; ip<np; ip++) {
+      enzo_float vp = cvv*v[ip*dv] + cva*a[ip*da];
+      x[ip*dp] += cp*vp;
+      vp = cvv*vp + cva*a[ip*da];
+      v[ip*dv] = vp;
+      dt_v_min = MIN(dt_v_min,h/MAX(fabs(vp),1e-6));
+      dt_a_min = MIN(dt_a_min,sqrt(2.0*h/MAX(fabs(a[ip*da]),1e-6)));
+    }
+    dt_v = dt_v_min;
+    dt_a = dt_a_min;
+  }
+
+  /// As update_axis_(), but for block-local integer positions x,
+  /// where cx converts a velocity times cp into position units
+  /// (2 PMAX per Block width).  Drift is rounded to the nearest unit
+  template <class T>
+  void update_axis_int_
+  (T * __restrict__ x,
+   enzo_float * __restrict__ v,
+   const enzo_float * __restrict__ a,
+   int np, int dp, int dv, int da,
+   double cx, double cvv, double cva, double h,
+   double & dt_v, double & dt_a)
+  {
+    double dt_v_min = dt_v;
+    double dt_a_min = dt_a;
+    for (int ip=0; ip<np; ip++) {
+      enzo_float vp = cvv*v[ip*dv] + cva*a[ip*da];
+      x[ip*dp] += (T) llrint(cx*vp);
+      vp = cvv*vp + cva*a[ip*da];
+      v[ip*dv] = vp;
+      dt_v_min = MIN(dt_v_min,h/MAX(fabs(vp),1e-6));
+      dt_a_min = MIN(dt_a_min,sqrt(2.0*h/MAX(fabs(a[ip*da]),1e-6)));
+    }
+    dt_v = dt_v_min;
+    dt_a = dt_a_min;
+  }
+
+  /// Arguments shared by the batches of one particle push
+  struct UpdateBatches {
+    Particle * particle;
+    int it, rank;
+    int ia_p[3], ia_v[3], ia_a[3];
+    int dp, dv, da;
+    int64_t pmax;
+    int type_p;
+    bool soa;
+    double cp, cvv, cva;
+    double h[3], cx[3];
+    /// Timestep bounds of each chunk, stored at its first batch
+    double * dt_v;
+    double * dt_a;
+  };
+
+  /// Push batches first to last (inclusive), reducing the timestep
+  /// bounds locally and storing them at index first.  The signature
+  /// is that of a CkLoop helper function
+  void update_batches_
+  (int first, int last, void * result, int num_params, void * params)
+  {
+    const UpdateBatches & u = *((UpdateBatches *) params);
+    Particle & particle = *u.particle;
+    const int it = u.it;
+
+    double dt_v = std::numeric_limits<double>::max();
+    double dt_a = std::numeric_limits<double>::max();
+
+    for (int ib=first; ib<=last; ib++) {
+
+      const int np = particle.num_particles(it,ib);
+
+      for (int axis=0; axis<u.rank; axis++) {
+
+	if (u.pmax != 0) {
+	  char * x = particle.attribute_array (it,u.ia_p[axis],ib);
+	  enzo_float * v =
+	    (enzo_float *) particle.attribute_array (it,u.ia_v[axis],ib);
+	  enzo_float * a =
+	    (enzo_float *) particle.attribute_array (it,u.ia_a[axis],ib);
+	  if (u.type_p == type_int64) {
+	    update_axis_int_ ((int64_t *)x,v,a,np,u.dp,u.dv,u.da,
+			      u.cx[axis],u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	  } else if (u.type_p == type_int32) {
+	    update_axis_int_ ((int32_t *)x,v,a,np,u.dp,u.dv,u.da,
+			      u.cx[axis],u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	  } else if (u.type_p == type_int16) {
+	    update_axis_int_ ((int16_t *)x,v,a,np,u.dp,u.dv,u.da,
+			      u.cx[axis],u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	  } else {
+	    update_axis_int_ ((int8_t *)x,v,a,np,u.dp,u.dv,u.da,
+			      u.cx[axis],u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	  }
+	} else if (u.soa) {
+	  update_axis_<1>
+	    (particle.attribute_array_soa<enzo_float>(it,u.ia_p[axis],ib),
+	     particle.attribute_array_soa<enzo_float>(it,u.ia_v[axis],ib),
+	     particle.attribute_array_soa<enzo_float>(it,u.ia_a[axis],ib),
+	     np,1,1,1, u.cp,u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	} else {
+	  update_axis_<0>
+	    ((enzo_float *) particle.attribute_array (it,u.ia_p[axis],ib),
+	     (enzo_float *) particle.attribute_array (it,u.ia_v[axis],ib),
+	     (enzo_float *) particle.attribute_array (it,u.ia_a[axis],ib),
+	     np,u.dp,u.dv,u.da, u.cp,u.cvv,u.cva,u.h[axis], dt_v,dt_a);
+	}
+      }
+    }
+
+    u.dt_v[first] = dt_v;
+    u.dt_a[first] = dt_a;
+  }
+
+}
+
+//----------------------------------------------------------------------
+
 EnzoMethodPmUpdate::EnzoMethodPmUpdate 
-( double max_dt ) 
+( double max_dt, std::string type ) 
   : Method(),
-    max_dt_(max_dt)
+    max_dt_(max_dt),
+    type_(type),
+    i_dt_v_(-1),
+    i_dt_a_(-1)
 {
   TRACE_PM("EnzoMethodPmUpdate()");
   // Initialize default Refresh object
@@ -46,6 +186,12 @@ EnzoMethodPmUpdate::EnzoMethodPmUpdate
 
   refresh(ir)->add_particle(particle_descr->type_index("dark"));
 
+  // Per-block timestep bounds saved by compute() for timestep()
+
+  ScalarDescr * scalar_descr_double = cello::scalar_descr_double();
+  i_dt_v_ = scalar_descr_double->new_value("pm_update:dt_v");
+  i_dt_a_ = scalar_descr_double->new_value("pm_update:dt_a");
+
   // PM parameters initialized in EnzoBlock::initialize()
 }
 
@@ -60,6 +206,9 @@ void EnzoMethodPmUpdate::pup (PUP::er &p)
   Method::pup(p);
 
   p | max_dt_;
+  p | type_;
+  p | i_dt_v_;
+  p | i_dt_a_;
 }
 
 //----------------------------------------------------------------------
@@ -68,15 +217,14 @@ void EnzoMethodPmUpdate::compute ( Block * block) throw()
 {
   TRACE_PM("compute()");
 
+  // Clear the timestep bounds saved by the previous call; they are
+  // set again below once the particles have been pushed
+
+  *dt_scalar_(block,i_dt_v_) = 0.0;
+  *dt_scalar_(block,i_dt_a_) = 0.0;
+
   if (block->is_leaf()) {
 
-#ifdef DEBUG_UPDATE    
-    double a3sum[3]={0.0};
-    double v3sum[3]={0.0};
-    double a3sum2[3]={0.0};
-    double v3sum2[3]={0.0};
-#endif    
-    
     EnzoPhysicsCosmology * cosmology = enzo::cosmology();
 
     enzo_float cosmo_a=1.0,cosmo_dadt=0.0;
@@ -93,17 +241,20 @@ void EnzoMethodPmUpdate::compute ( Block * block) throw()
     double dt_shift = 0.5*block->dt()/cosmo_a;
     //    double dt_shift = 0.0;
     if (rank >= 1) {
-      EnzoComputeCicInterp interp_x ("acceleration_x", "dark", "ax", dt_shift);
+      EnzoComputeCicInterp interp_x
+	("acceleration_x", "dark", "ax", dt_shift, type_);
       interp_x.compute(block);
     }
 
     if (rank >= 2) {
-      EnzoComputeCicInterp interp_y ("acceleration_y", "dark", "ay", dt_shift);
+      EnzoComputeCicInterp interp_y
+	("acceleration_y", "dark", "ay", dt_shift, type_);
       interp_y.compute(block);
     }
 
     if (rank >= 3) {
-      EnzoComputeCicInterp interp_z ("acceleration_z", "dark", "az", dt_shift);
+      EnzoComputeCicInterp interp_z
+	("acceleration_z", "dark", "az", dt_shift, type_);
       interp_z.compute(block);
     }
 
@@ -131,7 +282,9 @@ void EnzoMethodPmUpdate::compute ( Block * block) throw()
 
     const double dt = block->dt();
 
-    // check precisions match
+    // check precisions match (unless positions are block-local integers)
+
+    const int64_t pmax = particle.position_int_max(it);
     
     int ba = particle.attribute_bytes(it,ia_x); // "bytes (actual)"
     int be = sizeof(enzo_float);                // "bytes (expected)"
@@ -144,110 +297,89 @@ void EnzoMethodPmUpdate::compute ( Block * block) throw()
 	      ((ba == 8) ? "double" : "quadruple")),
 	     ((be == 4) ? "single" :
 	      ((be == 8) ? "double" : "quadruple")),
-	     (ba == be));
+	     (pmax != 0 || ba == be));
 
     const double cp = dt/cosmo_a;
     const double coef = 0.25*cosmo_dadt/cosmo_a*dt;
     const double cvv = (1.0 - coef) / (1.0 + coef);
     const double cva = 0.5*dt / (1.0 + coef);
 
-    for (int ib=0; ib<nb; ib++) {
-
-      enzo_float *x=0, *y=0, *z=0;
-      enzo_float *vx=0, *vy=0, *vz=0;
-      enzo_float *ax=0, *ay=0, *az=0;
-
-      if (rank >= 1) {
-	x  = (enzo_float *) particle.attribute_array (it, ia_x,  ib);
-	vx = (enzo_float *) particle.attribute_array (it, ia_vx, ib);
-	ax = (enzo_float *) particle.attribute_array (it, ia_ax, ib);
-      }
-      if (rank >= 2) {
-	y  = (enzo_float *) particle.attribute_array (it, ia_y,  ib);
-	vy = (enzo_float *) particle.attribute_array (it, ia_vy, ib);
-	ay = (enzo_float *) particle.attribute_array (it, ia_ay, ib);
-      }
-      if (rank >= 3) {
-	z  = (enzo_float *) particle.attribute_array (it, ia_z,  ib);
-	vz = (enzo_float *) particle.attribute_array (it, ia_vz, ib);
-	az = (enzo_float *) particle.attribute_array (it, ia_az, ib);
-      }
-
-      const int np = particle.num_particles(it,ib);
-
-      if (rank >= 1) {
-
-	for (int ip=0; ip<np; ip++) {
-
-	  const int ipdv = ip*dv;
-	  const int ipdp = ip*dp;
-	  const int ipda = ip*da;
-
-#ifdef DEBUG_UPDATE    
-	  v3sum[0]+=std::abs(vx[ipdv]);
-	  a3sum[0]+=std::abs(ax[ipda]);
-	  v3sum2[0]+=vx[ipdv]*vx[ipdv];
-	  a3sum2[0]+=ax[ipda]*ax[ipda];
-	  CkPrintf ("DEBUG_UPDATE x %g v %g a %g\n",x[ipdp],vx[ipdv],ax[ipda]);
-#endif	  
-	  vx[ipdv] = cvv*vx[ipdv] + cva*ax[ipda];
-	  x [ipdp] += cp*vx[ipdv];
-	  vx[ipdv] = cvv*vx[ipdv] + cva*ax[ipda];
-
-	}
-      }
-      if (rank >= 2) {
-
-	for (int ip=0; ip<np; ip++) {
-
-	  const int ipdv = ip*dv;
-	  const int ipdp = ip*dp;
-	  const int ipda = ip*da;
+    // Cell widths for the fused timestep bounds; the cosmological
+    // scale factor is applied in timestep()
 
-#ifdef DEBUG_UPDATE    
-	  v3sum[1]+=std::abs(vy[ipdv]);
-	  a3sum[1]+=std::abs(ay[ipda]);
-	  v3sum2[1]+=vy[ipdv]*vy[ipdv];
-	  a3sum2[1]+=ay[ipda]*ay[ipda];
-#endif	  
-	  vy[ipdv] = cvv*vy[ipdv] + cva*ay[ipda];
-	  y [ipdp] += cp*vy[ipdv];
-	  vy[ipdv] = cvv*vy[ipdv] + cva*ay[ipda];
-
-	}
-	
-      }
-      if (rank >= 3) {
-
-	for (int ip=0; ip<np; ip++) {
-
-	  const int ipdv = ip*dv;
-	  const int ipdp = ip*dp;
-	  const int ipda = ip*da;
-
-#ifdef DEBUG_UPDATE    
-	  v3sum[2]+=std::abs(vz[ipdv]);
-	  a3sum[2]+=std::abs(az[ipda]);
-	  v3sum2[2]+=vz[ipdv]*vz[ipdv];
-	  a3sum2[2]+=az[ipda]*az[ipda];
-#endif	  
+    double xm,ym,zm;
+    double xp,yp,zp;
+    block->lower(&xm,&ym,&zm);
+    block->upper(&xp,&yp,&zp);
 
-	  vz[ipdv] = cvv*vz[ipdv] + cva*az[ipda];
-	  z [ipdp] += cp*vz[ipdv];
-	  vz[ipdv] = cvv*vz[ipdv] + cva*az[ipda];
+    int nx,ny,nz;
+    block->data()->field().size(&nx,&ny,&nz);
+
+    const double hx = (xp-xm)/nx;
+    const double hy = (yp-ym)/ny;
+    const double hz = (zp-zm)/nz;
+
+    UpdateBatches u;
+
+    u.particle = &particle;
+    u.it   = it;
+    u.rank = rank;
+    u.ia_p[0] = ia_x;  u.ia_p[1] = ia_y;  u.ia_p[2] = ia_z;
+    u.ia_v[0] = ia_vx; u.ia_v[1] = ia_vy; u.ia_v[2] = ia_vz;
+    u.ia_a[0] = ia_ax; u.ia_a[1] = ia_ay; u.ia_a[2] = ia_az;
+    u.dp = dp;
+    u.dv = dv;
+    u.da = da;
+    u.pmax   = pmax;
+    u.type_p = particle.attribute_type(it,ia_x);
+
+    // non-interleaved attributes are unit-stride and aligned, so use
+    // the compile-time stride kernel that the compiler can vectorize
+
+    u.soa    = (! particle.interleaved(it));
+    u.cp  = cp;
+    u.cvv = cvv;
+    u.cva = cva;
+    u.h[0] = hx; u.h[1] = hy; u.h[2] = hz;
+
+    // block-local integer positions: 2 PMAX units per Block width
+
+    u.cx[0] = cp*2.0*pmax/(xp-xm);
+    u.cx[1] = cp*2.0*pmax/(yp-ym);
+    u.cx[2] = cp*2.0*pmax/(zp-zm);
+
+    // Timestep bounds of each chunk of batches, reduced below
+
+    std::vector<double> dt_v_chunk (nb,std::numeric_limits<double>::max());
+    std::vector<double> dt_a_chunk (nb,std::numeric_limits<double>::max());
+    u.dt_v = dt_v_chunk.data();
+    u.dt_a = dt_a_chunk.data();
+
+    // Batches are independent, so push them in parallel across the
+    // PEs of the node when CkLoop is available
+
+#ifdef CONFIG_USE_CKLOOP
+    const int num_chunks = MIN(nb,CkMyNodeSize());
+    if (num_chunks > 1) {
+      CkLoop_Parallelize (update_batches_, 1, &u, num_chunks, 0, nb-1);
+    } else if (nb > 0) {
+      update_batches_ (0, nb-1, NULL, 1, &u);
+    }
+#else
+    if (nb > 0) update_batches_ (0, nb-1, NULL, 1, &u);
+#endif
 
-	}
-      }
+    double dt_v = std::numeric_limits<double>::max();
+    double dt_a = std::numeric_limits<double>::max();
+    for (int ib=0; ib<nb; ib++) {
+      dt_v = MIN(dt_v,dt_v_chunk[ib]);
+      dt_a = MIN(dt_a,dt_a_chunk[ib]);
     }
     
-#ifdef DEBUG_UPDATE    
-    CkPrintf ("DEBUG_UPDATE asum %g %g %g vsum %g %g %g\n",
-	      a3sum[0],a3sum[1],a3sum[2],
-	      v3sum[0],v3sum[1],v3sum[2]);
-    CkPrintf ("DEBUG_UPDATE asum2 %g %g %g vsum2 %g %g %g\n",
-	      a3sum2[0],a3sum2[1],a3sum2[2],
-	      v3sum2[0],v3sum2[1],v3sum2[2]);
-#endif    
+    *dt_scalar_(block,i_dt_v_) = dt_v;
+    *dt_scalar_(block,i_dt_a_) = dt_a;
+
+    if (particle.sort_threshold() > 0.0) sort_particles_(block);
   }
 
   block->compute_done(); 
@@ -298,8 +430,8 @@ double EnzoMethodPmUpdate::timestep ( Block * block ) const throw()
     // Adjust for expansion terms if any
     EnzoPhysicsCosmology * cosmology = enzo::cosmology();
     
+    enzo_float cosmo_a=1.0,cosmo_dadt=0.0;
     if (cosmology) {
-      enzo_float cosmo_a=1.0,cosmo_dadt=0.0;
       double time = block->time();
       double dt   = block->dt();
       cosmology-> compute_expansion_factor (&cosmo_a,&cosmo_dadt,time+0.5*dt);
@@ -308,7 +440,22 @@ double EnzoMethodPmUpdate::timestep ( Block * block ) const throw()
       hz *= cosmo_a;
     }
 
-    for (int ib=0; ib<nb; ib++) {
+    // Use bounds saved by compute() if available, in which case the
+    // particle pass below is skipped.  They are left unchanged so
+    // that timestep() may be called more than once per cycle.
+
+    const double dt_v_saved = *dt_scalar_(block,i_dt_v_);
+    const double dt_a_saved = *dt_scalar_(block,i_dt_a_);
+
+    const bool saved = (dt_v_saved > 0.0);
+    if (saved) {
+      dt = MIN(dt,dt_v_saved*cosmo_a);
+      dt = MIN(dt,dt_a_saved*sqrt(cosmo_a));
+    }
+
+    const int nb_scan = saved ? 0 : nb;
+
+    for (int ib=0; ib<nb_scan; ib++) {
       const int np = particle.num_particles(it,ib);
 
       if (rank >= 1) {
@@ -362,3 +509,70 @@ double EnzoMethodPmUpdate::timestep ( Block * block ) const throw()
   dt = MIN(dt,max_dt_);
   return dt;
 }
+
+//----------------------------------------------------------------------
+
+void EnzoMethodPmUpdate::sort_particles_ ( Block * block ) throw()
+{
+  Particle particle = block->data()->particle();
+  Field    field    = block->data()->field();
+
+  const int rank = cello::rank();
+
+  const int it = particle.type_index ("dark");
+  const int nb = particle.num_batches (it);
+
+  if (particle.num_particles(it) < 2) return;
+
+  int nx,ny,nz;
+  field.size(&nx,&ny,&nz);
+  int gx,gy,gz;
+  field.ghost_depth(0,&gx,&gy,&gz);
+
+  double xm,ym,zm;
+  double xp,yp,zp;
+  block->lower(&xm,&ym,&zm);
+  block->upper(&xp,&yp,&zp);
+
+  // Key is the Morton index of the particle's lower-left CIC cell,
+  // matching the order used by EnzoMethodPmDeposit.  Deposit keys the
+  // position drifted by the next dt, which is not known yet, so its
+  // order is only nearly the same
+
+  const int n3[3] = { nx, ny, nz };
+  const int g3[3] = { gx, gy, gz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+
+  std::vector<int64_t> key;
+  key.reserve(particle.num_particles(it));
+
+  std::vector<int> index3[3];
+  std::vector<double> t3[3];
+
+  for (int ib=0; ib<nb; ib++) {
+    const int np = particle.num_particles(it,ib);
+    double * t[3] = { NULL, NULL, NULL };
+    for (int axis=0; axis<rank; axis++) {
+      t3[axis].resize(np);
+      t[axis] = t3[axis].data();
+    }
+    particle.position_cells (it,ib,n3,xm3,xp3,t[0],t[1],t[2]);
+    for (int axis=0; axis<3; axis++) {
+      index3[axis].assign(np,0);
+      if (axis >= rank) continue;
+      for (int ip=0; ip<np; ip++) {
+	const int i = g3[axis] + (int) floor(t[axis][ip] - 0.5);
+	index3[axis][ip] = MAX(i,0);
+      }
+    }
+    for (int ip=0; ip<np; ip++) {
+      key.push_back(cello::morton_key
+		    (index3[0][ip],index3[1][ip],index3[2][ip]));
+    }
+  }
+
+  if (particle.disorder(it,&key[0]) > particle.sort_threshold()) {
+    particle.sort(it,&key[0]);
+  }
+}
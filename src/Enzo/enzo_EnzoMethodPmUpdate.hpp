@@ -17,7 +17,7 @@ class EnzoMethodPmUpdate : public Method {
 public: // interface
 
   /// Create a new EnzoMethodPmUpdate object
-  EnzoMethodPmUpdate(double max_dt);
+  EnzoMethodPmUpdate(double max_dt, std::string type = "cic");
 
   /// Charm++ PUP::able declarations
   PUPable_decl(EnzoMethodPmUpdate);
@@ -25,7 +25,10 @@ public: // interface
   /// Charm++ PUP::able migration constructor
   EnzoMethodPmUpdate (CkMigrateMessage *m)
     : Method (m),
-      max_dt_(0.0)
+      max_dt_(0.0),
+      type_("cic"),
+      i_dt_v_(-1),
+      i_dt_a_(-1)
   { }
 
   /// CHARM++ Pack / Unpack function
@@ -40,10 +43,32 @@ public: // interface
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
+protected: // methods
+
+  /// Sort "dark" particles by cell if they are sufficiently out of order
+  void sort_particles_ (Block * block) throw();
+
+  /// Return a pointer to the Block's cached particle timestep bound
+  /// for index i_dt_v_ or i_dt_a_
+  double * dt_scalar_(Block * block, int index) const
+  {
+    ScalarData<double> * scalar_data = block->data()->scalar_data_double();
+    ScalarDescr *       scalar_descr = cello::scalar_descr_double();
+    return scalar_data->value(scalar_descr,index);
+  }
+
 protected: // attributes
 
   double max_dt_;
 
+  /// Particle interpolation type, "cic" or "tsc"
+  std::string type_;
+
+  /// Scalar indices for velocity and acceleration timestep bounds
+  /// computed during compute(), excluding cosmological scale factor
+  int i_dt_v_;
+  int i_dt_a_;
+
 };
 
 #endif /* ENZO_ENZO_METHOD_PM_UPDATE_HPP */
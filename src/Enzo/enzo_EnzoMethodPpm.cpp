@@ -21,9 +21,10 @@
 
 //----------------------------------------------------------------------
 
-EnzoMethodPpm::EnzoMethodPpm ()
+EnzoMethodPpm::EnzoMethodPpm (bool native)
   : Method(),
-    comoving_coordinates_(enzo::config()->physics_cosmology)
+    comoving_coordinates_(enzo::config()->physics_cosmology),
+    native_(native)
 {
   // Initialize default Refresh object
 
@@ -56,6 +57,7 @@ void EnzoMethodPpm::pup (PUP::er &p)
   Method::pup(p);
 
   p | comoving_coordinates_;
+  p | native_;
 }
 
 //----------------------------------------------------------------------
@@ -68,7 +70,7 @@ void EnzoMethodPpm::compute ( Block * block) throw()
   if (block->is_leaf()) {
     TRACE_PPM ("BEGIN SolveHydroEquations");
     enzo_block->SolveHydroEquations 
-      ( block->time(), block->dt(), comoving_coordinates_ );
+      ( block->time(), block->dt(), comoving_coordinates_, native_ );
     TRACE_PPM ("END SolveHydroEquations");
 
   }
@@ -126,25 +128,56 @@ double EnzoMethodPpm::timestep ( Block * block ) const throw()
    
   /* calculate minimum timestep */
 
-  FORTRAN_NAME(calc_dt)(&rank, 
-			enzo_block->GridDimension, 
-			enzo_block->GridDimension+1,
-			enzo_block->GridDimension+2,
-			enzo_block->GridStartIndex, 
-			enzo_block->GridEndIndex,
-			enzo_block->GridStartIndex+1, 
-			enzo_block->GridEndIndex+1,
-			enzo_block->GridStartIndex+2, 
-			enzo_block->GridEndIndex+2,
-			&enzo_block->CellWidth[0], 
-			&enzo_block->CellWidth[1], 
-			&enzo_block->CellWidth[2],
-			&EnzoBlock::Gamma[in], &EnzoBlock::PressureFree[in], &cosmo_a,
-			density, pressure,
-			velocity_x, 
-			velocity_y, 
-			velocity_z, 
-			&dtBaryons);
+  if (native_) {
+
+    const int m3[3] = { enzo_block->GridDimension[0],
+			enzo_block->GridDimension[1],
+			enzo_block->GridDimension[2] };
+    const enzo_float h3[3] = { enzo_block->CellWidth[0],
+			       enzo_block->CellWidth[1],
+			       enzo_block->CellWidth[2] };
+    const bool pressure_free = (EnzoBlock::PressureFree[in] == 1);
+
+    if (rank == 1) {
+      dtBaryons = timestep_native_<enzo_float,1>
+	(m3, enzo_block->GridStartIndex, enzo_block->GridEndIndex, h3,
+	 EnzoBlock::Gamma[in], pressure_free, cosmo_a,
+	 density, pressure, velocity_x, velocity_y, velocity_z);
+    } else if (rank == 2) {
+      dtBaryons = timestep_native_<enzo_float,2>
+	(m3, enzo_block->GridStartIndex, enzo_block->GridEndIndex, h3,
+	 EnzoBlock::Gamma[in], pressure_free, cosmo_a,
+	 density, pressure, velocity_x, velocity_y, velocity_z);
+    } else if (rank == 3) {
+      dtBaryons = timestep_native_<enzo_float,3>
+	(m3, enzo_block->GridStartIndex, enzo_block->GridEndIndex, h3,
+	 EnzoBlock::Gamma[in], pressure_free, cosmo_a,
+	 density, pressure, velocity_x, velocity_y, velocity_z);
+    }
+
+  } else {
+
+    FORTRAN_NAME(calc_dt)(&rank, 
+			  enzo_block->GridDimension, 
+			  enzo_block->GridDimension+1,
+			  enzo_block->GridDimension+2,
+			  enzo_block->GridStartIndex, 
+			  enzo_block->GridEndIndex,
+			  enzo_block->GridStartIndex+1, 
+			  enzo_block->GridEndIndex+1,
+			  enzo_block->GridStartIndex+2, 
+			  enzo_block->GridEndIndex+2,
+			  &enzo_block->CellWidth[0], 
+			  &enzo_block->CellWidth[1], 
+			  &enzo_block->CellWidth[2],
+			  &EnzoBlock::Gamma[in], &EnzoBlock::PressureFree[in],
+			  &cosmo_a,
+			  density, pressure,
+			  velocity_x, 
+			  velocity_y, 
+			  velocity_z, 
+			  &dtBaryons);
+  }
 
   TRACE1 ("dtBaryons: %f",dtBaryons);
 
@@ -154,3 +187,63 @@ double EnzoMethodPpm::timestep ( Block * block ) const throw()
 
   return dt;
 }
+
+//----------------------------------------------------------------------
+
+template <class T, int RANK>
+T EnzoMethodPpm::timestep_native_
+(const int m3[3], const int i1[3], const int i2[3],
+ const T h3[3], T gamma, bool pressure_free, T cosmo_a,
+ const T * d, const T * p,
+ const T * u, const T * v, const T * w) const throw()
+/// @param m3     Field array dimensions including ghost zones
+/// @param i1     Start index of the active region (0-based)
+/// @param i2     End index of the active region (0-based, inclusive)
+/// @param h3     Cell widths
+/// @param gamma  Ratio of specific heats
+/// @param pressure_free  Whether pressure is ignored (cs = tiny)
+/// @param cosmo_a Expansion factor, or 1 without comoving coordinates
+/// @param d,p    Density and pressure fields
+/// @param u,v,w  Velocity fields (unused ones may be NULL)
+///
+/// Returns the minimum allowed timestep without the Courant safety
+/// factor, using the same Godunov stability condition as calc_dt.F
+{
+  const int mx = m3[0];
+  const int my = m3[1];
+
+  // Unused axes are collapsed regardless of their ghost depths
+
+  const int iy1 = (RANK >= 2) ? i1[1] : 0;
+  const int iy2 = (RANK >= 2) ? i2[1] : 0;
+  const int iz1 = (RANK >= 3) ? i1[2] : 0;
+  const int iz2 = (RANK >= 3) ? i2[2] : 0;
+
+  const T cs_min = T(tiny);
+
+  T dt = T(huge);
+
+  for (int iz=iz1; iz<=iz2; iz++) {
+    for (int iy=iy1; iy<=iy2; iy++) {
+      const int i0 = mx*(iy + my*iz);
+      for (int ix=i1[0]; ix<=i2[0]; ix++) {
+	const int i = i0 + ix;
+	T cs = pressure_free ?
+	  cs_min : std::max(T(sqrt(gamma*p[i]/d[i])), cs_min);
+	T dt1;
+	if (RANK == 1) {
+	  dt1 = h3[0]*cosmo_a/(cs + fabs(u[i]));
+	} else if (RANK == 2) {
+	  dt1 = cosmo_a/((cs + fabs(u[i]))/h3[0] +
+			 (cs + fabs(v[i]))/h3[1]);
+	} else {
+	  dt1 = cosmo_a/((cs + fabs(u[i]))/h3[0] +
+			 (cs + fabs(v[i]))/h3[1] +
+			 (cs + fabs(w[i]))/h3[2]);
+	}
+	dt = std::min(dt,dt1);
+      }
+    }
+  }
+  return dt;
+}
@@ -17,7 +17,7 @@ class EnzoMethodPpm : public Method {
 public: // interface
 
   /// Create a new EnzoMethodPpm object
-  EnzoMethodPpm();
+  EnzoMethodPpm(bool native);
 
   /// Charm++ PUP::able declarations
   PUPable_decl(EnzoMethodPpm);
@@ -25,7 +25,8 @@ public: // interface
   /// Charm++ PUP::able migration constructor
   EnzoMethodPpm (CkMigrateMessage *m)
     : Method (m),
-      comoving_coordinates_(false)
+      comoving_coordinates_(false),
+      native_(false)
   {}
 
   /// CHARM++ Pack / Unpack function
@@ -42,9 +43,23 @@ public: // virtual methods
   /// Compute maximum timestep for this method
   virtual double timestep ( Block * block) const throw();
 
-protected: // interface
+protected: // methods
+
+  /// C++ replacement for the Fortran calc_dt() routine, specialized
+  /// on precision and rank at compile time
+  template <class T, int RANK>
+  T timestep_native_ (const int m3[3], const int i1[3], const int i2[3],
+		      const T h3[3], T gamma, bool pressure_free, T cosmo_a,
+		      const T * d, const T * p,
+		      const T * u, const T * v, const T * w) const throw();
+
+protected: // attributes
 
   bool comoving_coordinates_;
+
+  /// Whether to use the native C++ driver instead of the Fortran
+  /// calc_dt() and ppm_de() routines
+  bool native_;
 };
 
 #endif /* ENZO_ENZO_METHOD_PPM_HPP */
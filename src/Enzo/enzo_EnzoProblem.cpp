@@ -422,7 +422,7 @@ Method * EnzoProblem::create_method_
   
   if (name == "ppm") {
 
-    method = new EnzoMethodPpm;
+    method = new EnzoMethodPpm (enzo_config->ppm_native);
 
   } else if (name == "hydro") {
 
@@ -439,6 +439,8 @@ Method * EnzoProblem::create_method_
        enzo_config->method_hydro_reconstruct_positive,
        enzo_config->ppm_density_floor,
        enzo_config->ppm_pressure_floor,
+       enzo_config->ppm_temperature_floor,
+       enzo_config->ppm_mol_weight,
        enzo_config->ppm_pressure_free,
        enzo_config->ppm_diffusion,
        enzo_config->ppm_flattening,
@@ -452,18 +454,39 @@ Method * EnzoProblem::create_method_
 
   } else if (name == "pm_deposit") {
 
-    method = new EnzoMethodPmDeposit (enzo_config->method_pm_deposit_alpha);
+    method = new EnzoMethodPmDeposit
+      (enzo_config->method_pm_deposit_alpha,
+       enzo_config->method_pm_deposit_sort,
+       enzo_config->method_pm_deposit_type);
     
   } else if (name == "pm_update") {
 
     method = new EnzoMethodPmUpdate  
-      (enzo_config->method_pm_update_max_dt);
+      (enzo_config->method_pm_update_max_dt,
+       enzo_config->method_pm_update_type);
 
   } else if (name == "heat") {
 
+    // Crank-Nicolson if a linear solver is given, else forward Euler
+
+    std::string solver_name = enzo_config->method_heat_solver;
+
+    int index_solver = -1;
+
+    if (solver_name != "") {
+
+      index_solver = enzo_config->solver_index.at(solver_name);
+
+      ASSERT1 ("EnzoProblem::create_method_()",
+	       "Cannot find solver \"%s\"",
+	       solver_name.c_str(),
+	       0 <= index_solver && index_solver < enzo_config->num_solvers);
+    }
+
     method = new EnzoMethodHeat
       (enzo_config->method_heat_alpha,
-       config->method_courant[index_method]);
+       config->method_courant[index_method],
+       index_solver);
 
   } else if (name == "null") {
 
@@ -52,13 +52,41 @@ int EnzoRefineParticleMass::apply ( Block * block ) throw ()
   const int nb = particle.num_batches (it);
   const int dp = particle.stride(it,ia_x);
 
+  // block-local integer positions are counted in cell units
+
+  int nx,ny,nz;
+  block->data()->field().size(&nx,&ny,&nz);
+
+  const bool is_int = (particle.position_int_max(it) != 0);
+  const int    n3[3]  = { nx, ny, nz };
+  const double xm3[3] = { xm, ym, zm };
+  const double xp3[3] = { xp, yp, zp };
+  std::vector<double> t[3];
+
   size_t count = 0;
 
   for (int ib=0; ib<nb; ib++) {
 
     const int np = particle.num_particles (it,ib);
 
-    if (rank == 1) {
+    if (is_int) {
+
+      double * t3[3] = { NULL, NULL, NULL };
+      for (int axis=0; axis<rank; axis++) {
+	t[axis].resize(np);
+	t3[axis] = t[axis].data();
+      }
+      particle.position_cells (it,ib,n3,xm3,xp3,t3[0],t3[1],t3[2]);
+
+      for (int ip=0; ip<np; ip++) {
+	bool in = true;
+	for (int axis=0; axis<rank; axis++) {
+	  in = in && (0.0 <= t3[axis][ip] && t3[axis][ip] <= n3[axis]);
+	}
+	count += in ? 1 : 0;
+      }
+
+    } else if (rank == 1) {
 
       enzo_float * xa = (enzo_float *) particle.attribute_array (it,ia_x,ib);
 
@@ -97,8 +125,6 @@ int EnzoRefineParticleMass::apply ( Block * block ) throw ()
     }
   }
 
-  int nx,ny,nz;
-  block->data()->field().size(&nx,&ny,&nz);
   const double mass_min_refine  = min_refine_ * pow(2.0,level*level_exponent_);
   const double mass_max_coarsen = max_coarsen_* pow(2.0,level*level_exponent_);
 
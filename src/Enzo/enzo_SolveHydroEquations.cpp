@@ -8,6 +8,7 @@
 #include "cello.hpp"
 #include "enzo.hpp"
 #include <stdio.h>
+#include <algorithm>
 // #define DEBUG_TRACE_PPM
 // #define DEBUG_READ_FIELDS
 // #define DEBUG_WRITE_FIELDS
@@ -90,7 +91,8 @@ int EnzoBlock::SolveHydroEquations
 (
  enzo_float time,
  enzo_float dt,
- bool comoving_coordinates
+ bool comoving_coordinates,
+ bool native
  )
 {
   /* initialize */
@@ -391,30 +393,58 @@ int EnzoBlock::SolveHydroEquations
   int iconsrec = 0;
   int iposrec = 0;
 
-  FORTRAN_NAME(ppm_de)
-    (
-     density, total_energy, velocity_x, velocity_y, velocity_z,
-     internal_energy,
-     &gravity_on, 
-     acceleration_x,
-     acceleration_y,
-     acceleration_z,
-     &Gamma[in], &dt, &cycle_,
-     CellWidthTemp[0], CellWidthTemp[1], CellWidthTemp[2],
-     &rank, &GridDimension[0], &GridDimension[1],
-     &GridDimension[2], GridStartIndex, GridEndIndex,
-     &PPMFlatteningParameter[in],
-     &PressureFree[in],
-     &iconsrec, &iposrec,
-     &PPMDiffusionParameter[in], &PPMSteepeningParameter[in],
-     &DualEnergyFormalism[in], &DualEnergyFormalismEta1[in],
-     &DualEnergyFormalismEta2[in],
-     &NumberOfSubgrids, leftface, rightface,
-     istart, iend, jstart, jend,
-     standard, dindex, Eindex, uindex, vindex, windex,
-     geindex, temp,
-     &ncolour, colourpt, coloff, colindex
-     );
+  if (native) {
+
+    if (rank == 1) {
+      ppm_de_native_<1>
+	(density, total_energy, velocity_x, velocity_y, velocity_z,
+	 internal_energy, gravity_on,
+	 acceleration_x, acceleration_y, acceleration_z, dt,
+	 CellWidthTemp[0], CellWidthTemp[1], CellWidthTemp[2],
+	 temp, ncolour, colourpt, coloff);
+    } else if (rank == 2) {
+      ppm_de_native_<2>
+	(density, total_energy, velocity_x, velocity_y, velocity_z,
+	 internal_energy, gravity_on,
+	 acceleration_x, acceleration_y, acceleration_z, dt,
+	 CellWidthTemp[0], CellWidthTemp[1], CellWidthTemp[2],
+	 temp, ncolour, colourpt, coloff);
+    } else if (rank == 3) {
+      ppm_de_native_<3>
+	(density, total_energy, velocity_x, velocity_y, velocity_z,
+	 internal_energy, gravity_on,
+	 acceleration_x, acceleration_y, acceleration_z, dt,
+	 CellWidthTemp[0], CellWidthTemp[1], CellWidthTemp[2],
+	 temp, ncolour, colourpt, coloff);
+    }
+
+  } else {
+
+    FORTRAN_NAME(ppm_de)
+      (
+       density, total_energy, velocity_x, velocity_y, velocity_z,
+       internal_energy,
+       &gravity_on, 
+       acceleration_x,
+       acceleration_y,
+       acceleration_z,
+       &Gamma[in], &dt, &cycle_,
+       CellWidthTemp[0], CellWidthTemp[1], CellWidthTemp[2],
+       &rank, &GridDimension[0], &GridDimension[1],
+       &GridDimension[2], GridStartIndex, GridEndIndex,
+       &PPMFlatteningParameter[in],
+       &PressureFree[in],
+       &iconsrec, &iposrec,
+       &PPMDiffusionParameter[in], &PPMSteepeningParameter[in],
+       &DualEnergyFormalism[in], &DualEnergyFormalismEta1[in],
+       &DualEnergyFormalismEta2[in],
+       &NumberOfSubgrids, leftface, rightface,
+       istart, iend, jstart, jend,
+       standard, dindex, Eindex, uindex, vindex, windex,
+       geindex, temp,
+       &ncolour, colourpt, coloff, colindex
+       );
+  }
 
   for (dim = 0; dim < MAX_DIMENSION; dim++) {
     delete [] CellWidthTemp[dim];
@@ -501,3 +531,163 @@ int EnzoBlock::SolveHydroEquations
   return ENZO_SUCCESS;
 
 }
+
+//----------------------------------------------------------------------
+
+template <int RANK>
+void EnzoBlock::ppm_de_native_
+( enzo_float * d, enzo_float * e,
+  enzo_float * u, enzo_float * v, enzo_float * w, enzo_float * ge,
+  int gravity, enzo_float * gr_xacc, enzo_float * gr_yacc,
+  enzo_float * gr_zacc, enzo_float dt,
+  enzo_float * dx, enzo_float * dy, enzo_float * dz,
+  enzo_float * temp, int ncolor, enzo_float * colorpt, int * coloff)
+/// Performs the same directionally-split PPM update as ppm_de.F,
+/// calling the Fortran one-dimensional sweeps directly.  As in
+/// ppm_de.F, the temporary slices are cleared before every pencil.
+{
+  const int in = cello::index_static();
+
+  int mx = GridDimension[0];
+  int my = GridDimension[1];
+  int mz = GridDimension[2];
+
+  // The Fortran sweeps use fixed-size work arrays of this length
+
+  ASSERT4 ("EnzoBlock::ppm_de_native_()",
+	   "A grid dimension is too long: mx=%d my=%d mz=%d max=%d "
+	   "(increase MAX_ANY_SINGLE_DIRECTION)",
+	   mx,my,mz,MAX_ANY_SINGLE_DIRECTION,
+	   std::max(mx,std::max(my,mz)) <= MAX_ANY_SINGLE_DIRECTION);
+
+  // Convert to 1-based indices for the Fortran sweeps
+
+  int is = GridStartIndex[0] + 1;
+  int js = GridStartIndex[1] + 1;
+  int ks = GridStartIndex[2] + 1;
+  int ie = GridEndIndex[0] + 1;
+  int je = GridEndIndex[1] + 1;
+  int ke = GridEndIndex[2] + 1;
+
+  const int ms = std::max(mx*my, std::max(my*mz, mz*mx));
+
+#ifdef NEW_PPM
+  const int num_slices = 31;
+#else
+  const int num_slices = 30;
+#endif
+
+  // Size of temp as allocated in SolveHydroEquations() and cleared
+  // in ppm_de.F
+
+  const int ntmp = ms*(32 + 4*ncolor);
+
+  enzo_float * t[31];
+  for (int i=0; i<num_slices; i++) t[i] = temp + ms*i;
+  enzo_float * colslice = temp + ms*(num_slices + 0*ncolor);
+  enzo_float * colf     = temp + ms*(num_slices + 1*ncolor);
+  enzo_float * colls    = temp + ms*(num_slices + 2*ncolor);
+  enzo_float * colrs    = temp + ms*(num_slices + 3*ncolor);
+
+  // No subgrid fluxes are stored
+
+  int nsubgrids = 0;
+  int subgrid_index[1] = { 0 };
+  enzo_float subgrid_array[1] = { 0.0 };
+
+  int idual     = DualEnergyFormalism[in];
+  int idiff     = PPMDiffusionParameter[in];
+  int iflatten  = PPMFlatteningParameter[in];
+  int isteepen  = PPMSteepeningParameter[in];
+  int ipresfree = PressureFree[in];
+  int iconsrec  = 0;
+  int iposrec   = 0;
+  enzo_float eta1  = DualEnergyFormalismEta1[in];
+  enzo_float eta2  = DualEnergyFormalismEta2[in];
+  enzo_float gamma = Gamma[in];
+  enzo_float pmin  = tiny;
+
+  // Loop over directions, using a Strang-type splitting
+
+  const int ixyz = cycle_ % RANK;
+
+  for (int n=ixyz; n<ixyz+RANK; n++) {
+
+    const int axis = n % RANK;
+
+    if (axis == 0 && ie > is) {
+      for (int k=1; k<=mz; k++) {
+	std::fill_n(temp,ntmp,enzo_float(0.0));
+	FORTRAN_NAME(xeuler_sweep)
+	  (&k, d, e, u, v, w, ge, &mx, &my, &mz,
+	   &gravity, gr_xacc, &idual, &eta1, &eta2,
+	   &is, &ie, &js, &je, &ks, &ke,
+	   &gamma, &pmin, &dt, dx, dy, dz,
+	   &idiff, &iflatten, &isteepen, &iconsrec, &iposrec, &ipresfree,
+	   &nsubgrids, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_array,
+	   &ncolor, colorpt, coloff, subgrid_index,
+	   t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7],
+	   t[8], t[9], t[10],t[11],t[12],t[13],t[14],t[15],
+	   t[16],t[17],t[18],t[19],t[20],t[21],t[22],t[23],
+	   t[24],t[25],t[26],t[27],t[28],t[29],
+#ifdef NEW_PPM
+	   t[30],
+#endif
+	   colslice, colf, colls, colrs);
+      }
+    }
+
+    if (RANK >= 2 && axis == 1 && je > js) {
+      for (int i=1; i<=mx; i++) {
+	std::fill_n(temp,ntmp,enzo_float(0.0));
+	FORTRAN_NAME(yeuler_sweep)
+	  (&i, d, e, u, v, w, ge, &mx, &my, &mz,
+	   &gravity, gr_yacc, &idual, &eta1, &eta2,
+	   &is, &ie, &js, &je, &ks, &ke,
+	   &gamma, &pmin, &dt, dx, dy, dz,
+	   &idiff, &iflatten, &isteepen, &iconsrec, &iposrec, &ipresfree,
+	   &nsubgrids, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_array,
+	   &ncolor, colorpt, coloff, subgrid_index,
+	   t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7],
+	   t[8], t[9], t[10],t[11],t[12],t[13],t[14],t[15],
+	   t[16],t[17],t[18],t[19],t[20],t[21],t[22],t[23],
+	   t[24],t[25],t[26],t[27],t[28],t[29],
+#ifdef NEW_PPM
+	   t[30],
+#endif
+	   colslice, colf, colls, colrs);
+      }
+    }
+
+    if (RANK >= 3 && axis == 2 && ke > ks) {
+      for (int j=1; j<=my; j++) {
+	std::fill_n(temp,ntmp,enzo_float(0.0));
+	FORTRAN_NAME(zeuler_sweep)
+	  (&j, d, e, u, v, w, ge, &mx, &my, &mz,
+	   &gravity, gr_zacc, &idual, &eta1, &eta2,
+	   &is, &ie, &js, &je, &ks, &ke,
+	   &gamma, &pmin, &dt, dx, dy, dz,
+	   &idiff, &iflatten, &isteepen, &iconsrec, &iposrec, &ipresfree,
+	   &nsubgrids, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index,
+	   subgrid_index, subgrid_index, subgrid_index, subgrid_array,
+	   &ncolor, colorpt, coloff, subgrid_index,
+	   t[0], t[1], t[2], t[3], t[4], t[5], t[6], t[7],
+	   t[8], t[9], t[10],t[11],t[12],t[13],t[14],t[15],
+	   t[16],t[17],t[18],t[19],t[20],t[21],t[22],t[23],
+	   t[24],t[25],t[26],t[27],t[28],t[29],
+#ifdef NEW_PPM
+	   t[30],
+#endif
+	   colslice, colf, colls, colrs);
+      }
+    }
+  }
+}
@@ -663,8 +663,11 @@ if (file_exists("STATUS"))  {
 printf ("</th><td class=center colspan=5><em><a href=\"#enzop\">Enzo-P application tests</a></em></td></tr>\n");
 
 test_summary("Method: ppm",
-	     array("method_ppm-1","method_ppm-8"),
-	     array("enzo-p",  "enzo-p"),'test');
+	     array("method_ppm-1","method_ppm-8",
+		   "method_ppm_native-1","method_ppm_native-8",
+		   "method_ppm_native-compare-1","method_ppm_native-compare-8"),
+	     array("enzo-p",  "enzo-p", "enzo-p", "enzo-p",
+		   "enzo-p",  "enzo-p"),'test');
 
 test_summary("Method: ppml",
          array("method_ppml-1","method_ppml-8",
@@ -672,20 +675,26 @@ test_summary("Method: ppml",
          array("enzo-p",  "enzo-p", "enzo-p", "enzo-p"),'test');
 
 test_summary("Method: heat",
-	     array("method_heat-1","method_heat-8"),
-	     array("enzo-p",  "enzo-p"),'test');
+	     array("method_heat-1","method_heat-8",
+		   "method_heat_cn-1","method_heat_cn-8"),
+	     array("enzo-p",  "enzo-p", "enzo-p",  "enzo-p"),'test');
 
 test_summary("Method: gravity",
 	     array("method_gravity_cg-1","method_gravity_cg-8"),
 	     array("enzo-p",  "enzo-p"),'test');
 
 test_summary("Method: cosmology",
-	     array("method_cosmology-1","method_cosmology-8"),
-	     array("enzo-p",  "enzo-p"),'test');
+	     array("method_cosmology-1","method_cosmology-8","method_cosmology_sort-8"),
+	     array("enzo-p",  "enzo-p",  "enzo-p"),'test');
 
 test_summary("Checkpoint",
-	     array("checkpoint_ppm-1","checkpoint_ppm-8","restart_ppm-1","restart_ppm-8"),
-	     array("enzo-p",  "enzo-p", "enzo-p", "enzo-p"),'test');
+	     array("checkpoint_ppm-1","checkpoint_ppm-8","restart_ppm-1","restart_ppm-8",
+		   "restart_data-8","restart_data-1","restart_data-2",
+		   "restart_incremental-8","restart_incremental-1",
+		   "restart_incremental-2",
+		   "checkpoint_memory-8"),
+	     array("enzo-p",  "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p",
+		   "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p"),'test');
 
 test_summary("Adapt", 
 	     array("mesh-balanced"),
@@ -695,10 +704,11 @@ test_summary("Balance",
 	     array("balance_none",
 		   "balance_rand_cent",
 		   "balance_greedy",
+		   "balance_model",
 		   "balance_refine",
 		   "balance_rotate"),
 	     array("enzo-p", "enzo-p", "enzo-p", "enzo-p",
-		   "enzo-p"),'test/Balance');
+		   "enzo-p", "enzo-p"),'test/Balance');
 
 test_summary("Boundary", 
 	     array("boundary_reflecting-2d",
@@ -726,8 +736,9 @@ test_summary("Initial",
          array("enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p", "enzo-p"),'test');
 
 test_summary("Output", 
-	     array("output-stride-1","output-stride-2","output-stride-4"),
-	     array("enzo-p","enzo-p","enzo-p"),'test');
+	     array("output-stride-1","output-stride-2","output-stride-4",
+		   "output-reduce-8"),
+	     array("enzo-p","enzo-p","enzo-p","enzo-p"),'test');
 
 test_summary("Particle", 
 	     array("particle-x","particle-y","particle-xy","particle-circle","particle-amr-static","particle-amr-dynamic"),
@@ -847,6 +858,37 @@ test_table ("method_ppm-8",
 
 end_hidden("method_ppm-8");
 
+//----------------------------------------------------------------------
+
+begin_hidden("method_ppm_native-1", "PPM native driver (serial)");
+
+tests("Enzo","enzo-p","test_method_ppm_native-1","PPM native 1 block","");
+
+test_table ("method_ppm_native-1",
+	    array("000000","000200","000400"), $types);
+
+end_hidden("method_ppm_native-1");
+
+//----------------------------------------------------------------------
+
+begin_hidden("method_ppm_native-8", "PPM native driver (parallel)");
+
+tests("Enzo","enzo-p","test_method_ppm_native-8","PPM native 8 blocks","");
+
+test_table ("method_ppm_native-8",
+	    array("000000","000200","000400"), $types);
+
+end_hidden("method_ppm_native-8");
+
+//----------------------------------------------------------------------
+
+begin_hidden("method_ppm_native-compare", "PPM native driver compared with Fortran");
+
+tests("Enzo","enzo-p","test_method_ppm_native-compare-1","PPM native vs Fortran 1 block","");
+tests("Enzo","enzo-p","test_method_ppm_native-compare-8","PPM native vs Fortran 8 blocks","");
+
+end_hidden("method_ppm_native-compare");
+
 //======================================================================
 
 
@@ -948,6 +990,24 @@ test_table ("method_heat-mesh-8",
 
 end_hidden ("method_heat-8");
 
+  begin_hidden("method_heat_cn-1", "HEAT Crank-Nicolson (serial)");
+
+tests("Enzo","enzo-p","test_method_heat_cn-1","HEAT CN 1 block","");
+
+test_table ("method_heat_cn-temp-1",
+	    array("000000","000010","000020"), $types);
+
+end_hidden ("method_heat_cn-1");
+
+  begin_hidden("method_heat_cn-8", "HEAT Crank-Nicolson (parallel)");
+
+tests("Enzo","enzo-p","test_method_heat_cn-8","HEAT CN 8 block","");
+
+test_table ("method_heat_cn-temp-8",
+	    array("000000","000010","000020"), $types);
+
+end_hidden ("method_heat_cn-8");
+
 //======================================================================
 
 test_group("Method: gravity");
@@ -1068,6 +1128,18 @@ $types);
 
 end_hidden("method_cosmology-8");
 
+begin_hidden("method_cosmology_sort-8", "COSMOLOGY sorted deposit (parallel)");
+
+tests("Enzo","enzo-p","test_method_cosmology_sort-8","COSMOLOGY sorted deposit 8 blocks","");
+
+test_table_dir ("cosmo-sort-222", "Dir_COSMO_SORT8-0001",
+array("de-01",
+"dark-01",
+"po-01"),
+$types);
+
+end_hidden("method_cosmology_sort-8");
+
 //======================================================================
 
 test_group("Checkpoint");
@@ -1091,6 +1163,41 @@ test_table ("checkpoint_ppm-1",  array("000010","000020"), $types);
 
 end_hidden("checkpoint_ppm-8");
 
+//----------------------------------------------------------------------
+
+begin_hidden("restart_data-8","Restart from data dump (P=8 to P=1 and P=2)");
+
+tests("Enzo","enzo-p","test_restart_data-8","Data dump P=8","");
+tests("Enzo","enzo-p","test_restart_data-1","Restart P=1","");
+tests("Enzo","enzo-p","test_restart_data-2","Restart P=2","");
+test_table ("restart_data-8",  array("000010"), $types);
+test_table ("restart_data-1",  array("000020"), $types);
+test_table ("restart_data-2",  array("000020"), $types);
+
+end_hidden("restart_data-8");
+
+//----------------------------------------------------------------------
+
+begin_hidden("restart_incremental-8","Restart from incremental data dump (P=8 to P=1 and P=2)");
+
+tests("Enzo","enzo-p","test_restart_incremental-8","Incremental dump P=8","");
+tests("Enzo","enzo-p","test_restart_incremental-1","Restart P=1","");
+tests("Enzo","enzo-p","test_restart_incremental-2","Restart P=2","");
+test_table ("restart_incremental-8",  array("000010"), $types);
+test_table ("restart_incremental-1",  array("000020"), $types);
+test_table ("restart_incremental-2",  array("000020"), $types);
+
+end_hidden("restart_incremental-8");
+
+//----------------------------------------------------------------------
+
+begin_hidden("checkpoint_memory-8","In-memory checkpoint (P=8)");
+
+tests("Enzo","enzo-p","test_checkpoint_memory-8","Memory checkpoint P=8","");
+test_table ("checkpoint_memory-8",  array("000010","000020"), $types);
+
+end_hidden("checkpoint_memory-8");
+
 //======================================================================
 
 test_group("Adapt");
@@ -1165,6 +1272,16 @@ test_table ("Balance/Greedy/balance-de",
 
 end_hidden("balance_greedy");
 
+begin_hidden("balance_model", "GreedyLB (load model)");
+
+tests("Enzo","enzo-p","test_balance_model","Model","Balance");
+test_table ("Balance/Model/balance-mesh",
+	    array("00000","00002","00004","00006","00008","00010","00020"), $types);
+test_table ("Balance/Model/balance-de",
+	    array("00000","00002","00004","00006","00008","00010","00020"), $types);
+
+end_hidden("balance_model");
+
 // begin_hidden("balance_hybrid", "HybridLB");
 
 // tests("Enzo","enzo-p","test_balance_hybrid","Hybrid","Balance");
@@ -1306,6 +1423,11 @@ tests("Enzo","enzo-p","test_output-stride-4","","");
 test_table_blocks ("output-stride-4",  array("00","10","20"), $types);
 end_hidden("output_stride_4");
 
+begin_hidden("output_reduce_8", "In-situ reductions (P=8)");
+tests("Enzo","enzo-p","test_output-reduce-8","","");
+test_table ("output-reduce-8",  array("000010","000020"), $types);
+end_hidden("output_reduce_8");
+
 //----------------------------------------------------------------------
 
 test_group("Particle");
@@ -0,0 +1,85 @@
+#!/usr/bin/python
+#
+# Compare field data between two runs of the same problem
+#
+# usage: compare_fields.py <prefix-a> <prefix-b> [<rtol>]
+#
+# e.g. after running input/method_ppm-1.in and
+# input/method_ppm_native-1.in:
+#
+#    compare_fields.py test/method_ppm-1 test/method_ppm_native-1
+#
+# Data files <prefix-a>-*.h5 are matched with <prefix-b>-*.h5 by the
+# remainder of the file name, so both runs must use the same process
+# count and output schedule.  Blocks are matched by group name, and
+# every "field_*" dataset is compared.  Fields match if the maximum
+# of |a - b| is at most rtol times the maximum of |a| (default rtol
+# = 0, i.e. bitwise equal).  Results are written in the same format
+# as Cello unit tests, ending with "END CELLO", so they are counted by
+# test/index.php.
+
+import sys
+import os
+import glob
+import numpy as np
+import h5py
+
+def unit_print(passed, file_name, block, field):
+    """Print a result line in the format of Unit::assertion()"""
+    print ("%s %d/%d %s %d %s %s" %
+           (" pass " if passed else " FAIL ", 0, 1,
+            "compare_fields.py", 0, os.path.basename(file_name),
+            block + ":" + field))
+
+def compare_file(file_a, file_b, rtol):
+    """Compare all block fields in file_a with file_b"""
+    f_a = h5py.File(file_a, "r")
+    f_b = h5py.File(file_b, "r")
+    num_fail = 0
+    for block in sorted(f_a):
+        if not isinstance(f_a[block], h5py.Group):
+            continue
+        for field in sorted(f_a[block]):
+            if not field.startswith("field_"):
+                continue
+            a = np.array(f_a[block][field], dtype=np.float64)
+            if block in f_b and field in f_b[block]:
+                b = np.array(f_b[block][field], dtype=np.float64)
+                passed = (a.shape == b.shape and
+                          np.max(np.abs(a - b)) <= rtol*np.max(np.abs(a)))
+            else:
+                passed = False
+            unit_print(passed, file_a, block, field)
+            if not passed:
+                num_fail += 1
+    f_a.close()
+    f_b.close()
+    return num_fail
+
+def main(argv):
+    if len(argv) < 3:
+        print ("usage: %s <prefix-a> <prefix-b> [<rtol>]" % argv[0])
+        return 1
+    prefix_a = argv[1]
+    prefix_b = argv[2]
+    rtol = float(argv[3]) if len(argv) > 3 else 0.0
+
+    print ("UNIT TEST BEGIN")
+    files_a = sorted(glob.glob(prefix_a + "-*.h5"))
+    num_fail = 0
+    if len(files_a) == 0:
+        unit_print(False, prefix_a + "-*.h5", "none", "none")
+        num_fail += 1
+    for file_a in files_a:
+        file_b = prefix_b + file_a[len(prefix_a):]
+        if os.path.exists(file_b):
+            num_fail += compare_file(file_a, file_b, rtol)
+        else:
+            unit_print(False, file_b, "none", "none")
+            num_fail += 1
+    print ("UNIT TEST END")
+    print ("END CELLO")
+    return 1 if num_fail > 0 else 0
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
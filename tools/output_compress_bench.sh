@@ -0,0 +1,36 @@
+#!/bin/bash
+#
+# Compare HDF5 data output write time and file size between dataset
+# layouts
+#
+# usage: output_compress_bench.sh [<enzo-p> [<charmrun args>]]
+#
+# Runs input/output-compress-{contiguous,deflate,chunk,aggregate}.in from the
+# top-level directory, and reports the total "output" performance
+# region time and the total size of the written files for each
+
+enzo=${1:-bin/enzo-p}
+shift
+run="${@:+charmrun $@}"
+
+printf "%-12s %14s %14s %8s\n" "layout" "output-usec" "bytes" "ratio"
+
+bytes_ref=""
+
+for layout in contiguous deflate chunk aggregate; do
+
+    log=output-compress-$layout.log
+
+    rm -f output-compress-$layout-*.h5
+    $run $enzo input/output-compress-$layout.in > $log 2>&1
+
+    usec=`awk '/Performance output time-usec/{t=$NF} END{print t}' < $log`
+    bytes=`cat output-compress-$layout-*.h5 | wc -c`
+
+    if [ -z "$bytes_ref" ]; then bytes_ref=$bytes; fi
+
+    ratio=`awk "BEGIN{printf \"%.3f\", $bytes/$bytes_ref}"`
+
+    printf "%-12s %14s %14s %8s\n" $layout "$usec" $bytes $ratio
+
+done
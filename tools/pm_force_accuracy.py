@@ -0,0 +1,92 @@
+#!/usr/bin/python
+#
+# Compare particle accelerations between PM runs
+#
+# usage: pm_force_accuracy.py <ref-prefix> <run-prefix> [<run-prefix> ...]
+#
+# e.g. after running input/pm-force-{ref,cic,tsc,int,concat}.in:
+#
+#    pm_force_accuracy.py pm-force-ref pm-force-cic pm-force-tsc \
+#                         pm-force-int pm-force-concat
+#
+# Particles are matched by position on the particle lattice, so runs
+# must use the same initial particle placement.  Block-local integer
+# positions are converted using the block "lower" and "upper"
+# attributes.  Files written with particle_layout = "concatenate" are
+# read using the block "particle_dark_offset" and "particle_dark_count"
+# attributes.  Reports the RMS and maximum of |a - a_ref| relative to
+# the RMS reference acceleration.
+
+import sys
+import glob
+import numpy as np
+import h5py
+
+lattice = 64
+
+# PMAX for block-local integer positions, by size in bytes
+pmax = { 1 : 2**6, 2 : 2**14, 4 : 2**30, 8 : 2**62 }
+
+def attribute(f, block, name):
+    """Return the block's particle attribute, or None if no particles"""
+    name = "particle_dark_" + name
+    if name in block:
+        return np.array(block[name]).flatten()
+    if name in f and "particle_dark_offset" in block.attrs:
+        i0 = int(block.attrs["particle_dark_offset"][0])
+        n  = int(block.attrs["particle_dark_count"][0])
+        return f[name][i0:i0+n]
+    return None
+
+def position(f, block, axis):
+    """Return absolute particle positions along axis 0, 1, or 2"""
+    x = attribute(f, block, "xyz"[axis])
+    if np.issubdtype(x.dtype, np.integer):
+        lower = block.attrs["lower"][axis]
+        upper = block.attrs["upper"][axis]
+        u = x.astype(np.float64) / pmax[x.dtype.itemsize]
+        x = lower + 0.5*(u + 1.0)*(upper - lower)
+    return x
+
+def read_particles(prefix):
+    """Return dict lattice-index -> (ax,ay,az) over all block groups"""
+    accel = {}
+    for file_name in sorted(glob.glob(prefix + "-*.h5")):
+        f = h5py.File(file_name, "r")
+        for name in f:
+            block = f[name]
+            if not isinstance(block, h5py.Group):
+                continue
+            if attribute(f, block, "x") is None:
+                continue
+            x = position(f, block, 0)
+            y = position(f, block, 1)
+            z = position(f, block, 2)
+            a = [attribute(f, block, "a" + c) for c in "xyz"]
+            ix = np.floor(x*lattice).astype(int)
+            iy = np.floor(y*lattice).astype(int)
+            iz = np.floor(z*lattice).astype(int)
+            for i in range(len(x)):
+                accel[(ix[i],iy[i],iz[i])] = (a[0][i],a[1][i],a[2][i])
+        f.close()
+    return accel
+
+def compare(ref, run):
+    keys = [k for k in ref if k in run]
+    a_ref = np.array([ref[k] for k in keys])
+    a_run = np.array([run[k] for k in keys])
+    norm = np.sqrt(np.mean(np.sum(a_ref*a_ref,axis=1)))
+    err  = np.sqrt(np.sum((a_run-a_ref)**2,axis=1)) / norm
+    return len(keys), np.sqrt(np.mean(err*err)), np.max(err)
+
+if len(sys.argv) < 3:
+    print("usage: %s <ref-prefix> <run-prefix> [<run-prefix> ...]"
+          % sys.argv[0])
+    sys.exit(1)
+
+ref = read_particles(sys.argv[1])
+
+print("%-24s %8s %12s %12s" % ("run","matched","rms error","max error"))
+for prefix in sys.argv[2:]:
+    n, rms, emax = compare(ref, read_particles(prefix))
+    print("%-24s %8d %12.4e %12.4e" % (prefix, n, rms, emax))